@@ -0,0 +1,5 @@
+option(NANA_CMAKE_ENABLE_FINE_GRAINED_LOCK "Let the read-only queries (API::window_size, etc.) share a reader-writer lock instead of the global lock." OFF)
+
+if(NANA_CMAKE_ENABLE_FINE_GRAINED_LOCK)
+    target_compile_definitions(nana PUBLIC NANA_ENABLE_FINE_GRAINED_LOCK)
+endif()
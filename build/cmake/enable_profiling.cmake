@@ -0,0 +1,5 @@
+option(NANA_CMAKE_ENABLE_EVENT_PROFILING "Measure the latencies of the event handlers, drawers and flushes (see API::profiling)." OFF)
+
+if(NANA_CMAKE_ENABLE_EVENT_PROFILING)
+    target_compile_definitions(nana PUBLIC NANA_ENABLE_EVENT_PROFILING)
+endif()
@@ -44,6 +44,8 @@ if (NANA_CMAKE_VERBOSE_PREPROCESSOR)
     message ( "NANA_INCLUDE_DIR          = "  ${NANA_INCLUDE_DIR})
     message ( "CMAKE_CURRENT_SOURCE_DIR  = "  ${CMAKE_CURRENT_SOURCE_DIR})
     message ( "NANA_CMAKE_ENABLE_AUDIO   = "  ${NANA_CMAKE_ENABLE_AUDIO})
+    message ( "NANA_CMAKE_ENABLE_EVENT_PROFILING = "  ${NANA_CMAKE_ENABLE_EVENT_PROFILING})
+    message ( "NANA_CMAKE_ENABLE_FINE_GRAINED_LOCK = "  ${NANA_CMAKE_ENABLE_FINE_GRAINED_LOCK})
     message ( "NANA_CMAKE_SHARED_LIB     = "  ${NANA_CMAKE_SHARED_LIB})
     message ( "CMAKE_MAKE_PROGRAM      = "  ${CMAKE_MAKE_PROGRAM})
     message ( "CMAKE_CXX_COMPILER_VERSION = " ${CMAKE_CXX_COMPILER_VERSION})
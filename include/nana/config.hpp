@@ -16,6 +16,12 @@
  *	- NANA_LIBJPEG, USE_LIBJPEG_FROM_OS
  *  - NANA_ENABLE_AUDIO
  *
+ *	diagnostics:
+ *	- NANA_ENABLE_EVENT_PROFILING
+ *
+ *	threading:
+ *	- NANA_ENABLE_FINE_GRAINED_LOCK
+ *
  *	messages:
  *	- VERBOSE_PREPROCESSOR, STOP_VERBOSE_PREPROCESSOR
  */
@@ -93,6 +99,21 @@
 	#endif
 #endif
 
+///////////////////
+//  Event profiling
+//	  Define the NANA_ENABLE_EVENT_PROFILING to measure the latencies of event handlers, drawers
+//	  and flushes. The histograms are retrieved through API::profiling.
+//
+//#define NANA_ENABLE_EVENT_PROFILING
+
+///////////////////
+//  Fine-grained lock
+//	  Define the NANA_ENABLE_FINE_GRAINED_LOCK to let the read-only queries, such as API::is_window,
+//	  API::window_size and API::window_rectangle, share a reader-writer lock of the window registry
+//	  instead of the global lock, so that they are not blocked by the event processing of the GUI thread.
+//
+//#define NANA_ENABLE_FINE_GRAINED_LOCK
+
 ///////////////////
 //  Support for NANA_AUTOMATIC_GUI_TESTING
 //	  Will cause the program to self-test the GUI. A default automatic GUI test 
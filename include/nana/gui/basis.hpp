@@ -19,6 +19,7 @@
 
 #include "../basic_types.hpp"
 #include "../traits.hpp"	//metacomp::fixed_type_set
+#include <chrono>
 
 namespace nana
 {
@@ -320,6 +321,46 @@ that return a corresponding nana::appearance with predefined values.
 		virtual bool visible(bool vert) const = 0;
 	};
 
+	/// Statistics of the frame pacing of a root window
+	struct frame_statistics
+	{
+		unsigned	rate{ 0 };			///< The frame rate in Hz, zero if the frame pacing is disabled.
+		std::size_t	frames{ 0 };		///< The number of frames which have been flushed to the screen.
+		std::size_t	requests{ 0 };		///< The number of update requests which have been received.
+		std::size_t	coalesced{ 0 };		///< The number of requests which were merged into a pending frame of the same window.
+		std::chrono::microseconds last_flush{ 0 };	///< The time which was spent on flushing the last frame.
+		std::chrono::microseconds max_flush{ 0 };	///< The maximum time which was spent on flushing a frame.
+	};
+
+	/// The phases of processing an event which are measured by the event profiling
+	enum class event_phase
+	{
+		handler,	///< The event handlers which are registered by the program.
+		refresh,	///< The drawer of the widget which answers the event.
+		flush,		///< Refreshing the windows which are updated by the event, and copying them to the screen.
+		end			///< End indicator, it's not a phase.
+	};
+
+	/// A histogram of the latencies of an event phase, available when NANA_ENABLE_EVENT_PROFILING is defined.
+	/**
+	 * The i-th bucket counts the samples in [2^(i-1), 2^i) microseconds, the first bucket counts the samples
+	 * shorter than 1 microsecond and the last bucket counts all the longer samples.
+	 */
+	struct latency_histogram
+	{
+		static constexpr std::size_t bucket_count = 24;
+
+		std::size_t	samples{ 0 };
+		std::chrono::microseconds total{ 0 };
+		std::chrono::microseconds max{ 0 };
+		std::size_t	buckets[bucket_count]{};
+
+		const char* slowest_widget{ nullptr };	///< The type name of the widget which took the max time, nullptr if it is unknown.
+
+		/// Returns the upper bound of the bucket which contains the specified percentile, e.g. 0.99.
+		std::chrono::microseconds percentile(double ratio) const;
+	};
+
 	namespace parameters
 	{
 		/// The system-wide parameters for mouse wheel
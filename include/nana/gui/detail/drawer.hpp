@@ -16,6 +16,7 @@
 #include <nana/push_ignore_diagnostic>
 #include "general_events.hpp"
 #include <nana/paint/graphics.hpp>
+#include <chrono>
 #include <functional>
 #include <vector>
 
@@ -146,6 +147,18 @@ namespace nana
 			void shortkey(const arg_keyboard&, const bool);
 			void map(window, bool forced, const rectangle* update_area = nullptr);	//Copy the root buffer to screen
 			void refresh();
+
+			/// Makes and renders the graphics of a widget with transient backing if it is released, and records the time of use.
+			/**
+			 * @return true if the graphics is made.
+			 */
+			bool acquire_transient();
+
+			/// Releases the graphics of a widget with transient backing, it's called when the widget is idle.
+			void release_transient();
+
+			/// Returns the time when the graphics of a widget with transient backing was used last.
+			std::chrono::steady_clock::time_point transient_used() const;
 			drawer_trigger* realizer() const;
 			void attached(widget&, drawer_trigger&);
 			drawer_trigger* detached();
@@ -167,6 +180,9 @@ namespace nana
 
 				if (realizer && (method_state::not_overridden != mth_state))
 				{
+					//The handler may draw on the graphics partially, it should be available
+					acquire_transient();
+
 					const bool bFiltered = !bForce__EmitInternal && realizer->filter_event(evt_code);
 					if (method_state::pending == mth_state)
 					{
@@ -14,15 +14,28 @@ namespace nana
 {
 	namespace detail
 	{
+		/// The registry of the event handles.
+		/**
+		 * The handles are distributed over several shards by their addresses, every shard has its own
+		 * mutex, so that the threads which connect handlers at the same time rarely contend for a lock.
+		 */
 		class events_operation
 		{
+			static constexpr std::size_t shard_count = 16;
+
+			struct shard
+			{
+				std::mutex mutex;
+				std::unordered_set<event_handle> handles;
+			};
 		public:
 			void register_evt(event_handle);
 			void cancel(event_handle);
 			void erase(event_handle);
 		private:
-			std::recursive_mutex mutex_;
-			std::unordered_set<event_handle>	handles_;
+			shard& _m_shard(event_handle);
+		private:
+			shard shards_[shard_count];
 		};
 	}//end namespace detail
 }//end namespace nana
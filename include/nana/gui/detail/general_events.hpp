@@ -57,6 +57,12 @@ namespace nana
 
 			docker_base(event_interface*, bool unignorable_flag);
 			detail::event_interface * get_event() const override;
+
+			/// The dockers are allocated from a slab pool which is shared by all events, because a large form
+			/// connects tens of thousands of handlers. The size is passed to the operator delete by the virtual
+			/// destructor, so each size class is recycled without a header.
+			static void* operator new(std::size_t);
+			static void operator delete(void*, std::size_t) noexcept;
 		};
 
 		class event_base
@@ -122,17 +128,37 @@ namespace nana
 		struct docker
 			: public detail::docker_base
 		{
-			/// the callback/response function taking the typed argument
-			std::function<void(arg_reference)> invoke;
-
-			docker(basic_event * evt, std::function<void(arg_reference)> && ivk, bool unignorable_flag)
-				: docker_base(evt, unignorable_flag), invoke(std::move(ivk))
+			docker(basic_event * evt, bool unignorable_flag)
+				: docker_base(evt, unignorable_flag)
 			{}
 
-			docker(basic_event * evt, const std::function<void(arg_reference)> & ivk, bool unignorable_flag)
-				: docker_base(evt, unignorable_flag), invoke(ivk)
+			/// calls the callback/response function taking the typed argument
+			virtual void invoke(arg_reference) = 0;
+		};
+
+		/// The callable is stored inside the docker, so connecting a handler is a single allocation from the pool.
+		template<typename Function>
+		struct docker_fn
+			: public docker
+		{
+			Function fn;
+
+			template<typename Fn>
+			docker_fn(basic_event * evt, Fn && f, bool unignorable_flag)
+				: docker(evt, unignorable_flag), fn(std::forward<Fn>(f))
 			{}
+
+			void invoke(arg_reference arg) override
+			{
+				fn(arg);
+			}
 		};
+
+		template<typename Function>
+		static docker* _m_make_docker(basic_event* evt, Function&& fn, bool unignorable_flag)
+		{
+			return new docker_fn<typename std::decay<Function>::type>(evt, std::forward<Function>(fn), unignorable_flag);
+		}
 	public:
 		/// Creates an event handler at the beginning of event chain
 		template<typename Function>
@@ -141,17 +167,17 @@ namespace nana
 #ifdef __cpp_if_constexpr
 			if constexpr(std::is_invocable_v<Function, arg_reference>)
 			{
-				return _m_emplace(new docker{ this, fn, false }, true);
+				return _m_emplace(_m_make_docker(this, std::forward<Function>(fn), false), true);
 			}
 			else if constexpr(std::is_invocable_v<Function>)
 			{
-				return _m_emplace(new docker{ this, [fn](arg_reference) {
+				return _m_emplace(_m_make_docker(this, [fn](arg_reference) {
 					fn();
-				}, false }, true);
+				}, false), true);
 			}
 #else
 			using prototype = typename std::remove_reference<Function>::type;
-			return _m_emplace(new docker(this, factory<prototype, std::is_bind_expression<prototype>::value>::build(std::forward<Function>(fn)), false), true);
+			return _m_emplace(_m_make_docker(this, factory<prototype, std::is_bind_expression<prototype>::value>::build(std::forward<Function>(fn)), false), true);
 #endif
 		}
 
@@ -172,17 +198,17 @@ namespace nana
 #ifdef __cpp_if_constexpr
 			if constexpr(std::is_invocable_v<Function, arg_reference>)
 			{
-				return _m_emplace(new docker{ this, fn, false }, false);
+				return _m_emplace(_m_make_docker(this, std::forward<Function>(fn), false), false);
 			}
 			else if constexpr(std::is_invocable_v<Function>)
 			{
-				return _m_emplace(new docker{ this, [fn](arg_reference) mutable{
+				return _m_emplace(_m_make_docker(this, [fn](arg_reference) mutable{
 					fn();
-				}, false }, false);
+				}, false), false);
 			}
 #else
 			using prototype = typename std::remove_reference<Function>::type;
-			return _m_emplace(new docker(this, factory<prototype, std::is_bind_expression<prototype>::value>::build(std::forward<Function>(fn)), false), false);
+			return _m_emplace(_m_make_docker(this, factory<prototype, std::is_bind_expression<prototype>::value>::build(std::forward<Function>(fn)), false), false);
 #endif
 		}
 
@@ -200,17 +226,17 @@ namespace nana
 #ifdef __cpp_if_constexpr
 			if constexpr(std::is_invocable_v<Function, arg_reference>)
 			{
-				return _m_emplace(new docker{ this, fn, true }, in_front);
+				return _m_emplace(_m_make_docker(this, std::forward<Function>(fn), true), in_front);
 			}
 			else if constexpr(std::is_invocable_v<Function>)
 			{
-				return _m_emplace(new docker{ this, [fn](arg_reference) mutable{
+				return _m_emplace(_m_make_docker(this, [fn](arg_reference) mutable{
 					fn();
-				}, true }, in_front);
+				}, true), in_front);
 			}
 #else
 			using prototype = typename std::remove_reference<Function>::type;
-			return _m_emplace(new docker(this, factory<prototype, std::is_bind_expression<prototype>::value>::build(std::forward<Function>(fn)), true), in_front);
+			return _m_emplace(_m_make_docker(this, factory<prototype, std::is_bind_expression<prototype>::value>::build(std::forward<Function>(fn)), true), in_front);
 #endif
 		}
 
@@ -27,6 +27,24 @@ namespace nana
 		~internal_scope_guard();
 	};
 
+	/// The lock for the read-only queries, such as API::window_size.
+	/**
+	 * It locks the internal lock as internal_scope_guard does. If NANA_ENABLE_FINE_GRAINED_LOCK is defined,
+	 * it only shares the lock of the window registry with other readers, so that a query from a worker
+	 * thread is not blocked by the event processing of the GUI thread.
+	 */
+	class internal_shared_guard
+	{
+		internal_shared_guard(const internal_shared_guard&) = delete;
+		internal_shared_guard(internal_shared_guard&&) = delete;
+
+		internal_shared_guard& operator=(const internal_shared_guard&) = delete;
+		internal_shared_guard& operator=(internal_shared_guard&&) = delete;
+	public:
+		internal_shared_guard();
+		~internal_shared_guard();
+	};
+
 	class internal_revert_guard
 	{
 		internal_revert_guard(const internal_revert_guard&) = delete;
@@ -47,9 +47,15 @@ namespace detail
 			try_refresh
 		};
 	public:
-		static void paint(basic_window*, paint_operation, bool request_refresh_children);
+		/// Paints a window to the root graphics.
+		/**
+		 * @param damage The area to be copied to the root graphics, in the coordinate of the root window. The whole
+		 * visual rectangle of the window is copied if it is nullptr. It is ignored if the children are requested to be
+		 * refreshed, or the window has a bground effect.
+		 */
+		static void paint(basic_window*, paint_operation, bool request_refresh_children, const rectangle* damage = nullptr);
 
-		static bool maproot(basic_window*, bool have_refreshed, bool request_refresh_children);
+		static bool maproot(basic_window*, bool have_refreshed, bool request_refresh_children, const rectangle* damage = nullptr);
 
 		static void paste_children_to_graphics(basic_window*, nana::paint::graphics& graph);
 
@@ -82,10 +88,15 @@ namespace detail
 		 */
 		static void _m_paste_children(basic_window* window, bool has_refreshed, bool request_refresh_children, const nana::rectangle& parent_rect, nana::paint::graphics& graph, const nana::point& graph_rpos);
 
+		/// Paints a glass window, its glass buffer is made again only if the background is damaged.
 		static void _m_paint_glass_window(basic_window*, bool is_redraw, bool is_child_refreshed, bool called_by_notify, bool notify_other);
 
-		//Notify the windows which have brground to update their background buffer.
-		static void _m_notify_glasses(basic_window* const sigwd);
+		/// Notifies the glass windows which are covered by the damaged area of a window to update their background buffer.
+		/**
+		 * @param sigwd The window which is painted.
+		 * @param damage The painted area of sigwd, in the coordinate of the root window.
+		 */
+		static void _m_notify_glasses(basic_window* const sigwd, const nana::rectangle& damage);
 	private:
 		struct data_section
 		{
@@ -22,11 +22,13 @@
 
 #include "event_code.hpp"
 #include "inner_fwd.hpp"
+#include <chrono>
 #include <functional>
 
 namespace nana
 {
 	class widget;	//forward declaration
+	struct frame_statistics;
 	namespace paint
 	{
 		class image;
@@ -67,11 +69,31 @@ namespace detail
 		using native_window = native_window_type;
 		using mutex_type = revertible_mutex;
 
+		/// Locks the window registry exclusively while a window is registered/unregistered or its geometry is changed.
+		/// It does nothing unless NANA_ENABLE_FINE_GRAINED_LOCK is defined.
+		class registry_write_guard
+		{
+			registry_write_guard(const registry_write_guard&) = delete;
+			registry_write_guard& operator=(const registry_write_guard&) = delete;
+		public:
+			registry_write_guard(const window_manager&);
+			~registry_write_guard();
+		private:
+			const window_manager& wd_mngr_;
+		};
+
 		window_manager();
 		~window_manager();
 
 		std::size_t window_count() const;
 		mutex_type & internal_lock() const;
+
+		/// Locks for the read-only queries, see internal_shared_guard.
+		void lock_shared() const;
+		void unlock_shared() const;
+
+		/// Determines whether a window is registered. The caller shall hold the internal lock or the shared lock.
+		bool registered(basic_window*) const;
 		void all_handles(std::vector<basic_window*>&) const;
 
 		void event_filter(basic_window*, bool is_make, event_code);
@@ -120,6 +142,40 @@ namespace detail
 
 		void do_lazy_refresh(basic_window*, bool force_copy_to_screen, bool refresh_tree = false);
 
+		/// Starts a geometry batch of the root window of a window.
+		/**
+		 * In a batch, the resized events are deferred and emitted once per window at commit, and the updates of the windows
+		 * are deferred as the lazy update does. The deferred windows are painted and the union of their visual rectangles is
+		 * copied to the screen at once, by the outermost commit, or by the end of the event if the batch is committed in an event.
+		 * @return The root window of the batch, it is passed to commit_geometry_batch. nullptr if the window is invalid.
+		 */
+		basic_window* begin_geometry_batch(basic_window*);
+		void commit_geometry_batch(basic_window* root_wd);
+
+		/// The budget of the graphics of the windows in bytes, zero means unlimited. See backing_store_collector.
+		void backing_store_budget(std::size_t bytes);
+		std::size_t backing_store_budget() const;
+
+		/// The time for which a widget is hidden before its graphics is released, zero disables it.
+		void backing_store_threshold(std::chrono::milliseconds);
+		std::chrono::milliseconds backing_store_threshold() const;
+
+		std::size_t backing_store_usage() const;
+
+		/// Records a widget whose transient backing is enabled or disabled, its graphics is released when it is idle.
+		void transient_backing(basic_window*, bool enabled);
+
+		//Frame pacing of a root window. A zero rate disables the frame pacing.
+		void frame_rate(basic_window*, unsigned hz);
+		unsigned frame_rate(basic_window*) const;
+
+		/// Refreshes a window and flushes it to the screen in next frame.
+		void request_frame(basic_window*);
+		frame_statistics frame_stats(basic_window*) const;
+
+		/// Flushes the pending updates of a root window to the screen
+		void commit_frame(basic_window* root_wd);
+
 		bool set_parent(basic_window* wd, basic_window* new_parent);
 		basic_window* set_focus(basic_window*, bool root_has_been_focused, arg_focus::reason);
 
@@ -152,8 +208,17 @@ namespace detail
 		void _m_destroy(basic_window*);
 		void _m_move_core(basic_window*, const point& delta);
 		void _m_shortkeys(basic_window*, bool with_chlidren, std::vector<std::pair<basic_window*, unsigned long>>& keys) const;
-		basic_window* _m_find(basic_window*, const point&);
 		static bool _m_effective(basic_window*, const point& root_pos);
+
+		/// Invalidates the hit index of the root window of a window, after the windows are created, destroyed or reparented.
+		void _m_invalidate_hits(basic_window*);
+
+		/// Updates the hit index after a window is moved or resized.
+		void _m_update_hits(basic_window*, bool with_children);
+
+		/// Defers the flush of a window to next frame if frame pacing is enabled for its root window.
+		bool _m_defer_frame(basic_window*, const rectangle* update_area, bool redraw);
+		void _m_commit_frame(root_misc*);
 	private:
 		mutable mutex_type mutex_;
 
@@ -18,6 +18,8 @@
 #include "detail/color_schemes.hpp"
 #include "detail/widget_content_measurer_interface.hpp"
 #include <nana/paint/image.hpp>
+#include <chrono>
+#include <iosfwd>
 #include <memory>
 
 namespace nana
@@ -346,6 +348,36 @@ namespace API
 	::std::optional<rectangle> window_rectangle(window);
 	bool get_window_rectangle(window, rectangle&);
 	bool track_window_size(window, const size&, bool true_for_max);   ///< Sets the minimum or maximum tracking size of a window.
+
+	/// Batches the moves and resizes of the windows which belong to a root window.
+	/**
+	 * In a batch, the resized event of a window is emitted once with its final size, and the windows are not
+	 * painted when they are moved or resized. When the outermost batch of the root window is committed, the
+	 * events are emitted, and the windows are painted and the union of them is copied to the screen at once. If the batch
+	 * is committed in an event handler, the copy is made when the event is finished.
+	 * It should be used in the thread which created the window. For example
+	 *	{
+	 *		API::geometry_batch batch{ form };
+	 *		for (auto & r : layout)
+	 *			API::move_window(r.first, r.second);
+	 *	}	//Committed
+	 */
+	class geometry_batch
+	{
+		geometry_batch(const geometry_batch&) = delete;
+		geometry_batch& operator=(const geometry_batch&) = delete;
+	public:
+		/// Begins a batch of the root window to which the specified window belongs.
+		geometry_batch(window);
+
+		/// Commits the batch if it is not committed, the exceptions thrown by the event handlers are discarded.
+		~geometry_batch();
+
+		/// Commits the batch, the exceptions thrown by the event handlers are propagated and the batch is closed.
+		void commit();
+	private:
+		window window_;	///< The root window of the batch.
+	};
 	void window_enabled(window, bool);
 	bool window_enabled(window);
 
@@ -358,6 +390,98 @@ namespace API
 	void refresh_window_tree(window);      ///< Refreshes the specified window and all its children windows, then displays it immediately
 	void update_window(window);            ///< Copies the off-screen buffer to the screen for immediate display.
 
+	/// Refreshes the window, and only copies the damaged area to the screen.
+	/**
+	 * It's used when the drawer only changes a part of the window, such as a cell or a caret, so that the other
+	 * parts of the window are not copied to the root buffer and the screen.
+	 * @param wd A handle to the window.
+	 * @param damage The damaged area, in the coordinate of the window.
+	 */
+	void refresh_window(window wd, const rectangle& damage);
+	void update_window(window, const rectangle& damage);	///< Copies the damaged area of the off-screen buffer to the screen.
+
+	/// Enables or disables the transient backing of a widget.
+	/**
+	 * A widget owns an off-screen graphics which keeps its content, it costs a pixmap for each widget. With the transient
+	 * backing, the graphics is released when the widget has been idle for a second, neither painted nor handling an event,
+	 * and it's made and rendered again by the drawer when it is needed, such as when the parent is redrawn. The graphics
+	 * is kept while the widget is in use, so that the interaction doesn't render it again. It trades the rendering time
+	 * for the memory, it suits the widgets which are cheap to render and are rarely redrawn. The drawer must render the whole content in
+	 * refresh(), because the content which is drawn by the other handlers is not kept.
+	 * @param wd A handle to the widget. Lite widgets, root windows and the widgets which have a bground effect are not supported.
+	 * @param enabled Indicates whether to enable the transient backing.
+	 * @return true if the mode of the widget is set.
+	 */
+	bool transient_backing(window wd, bool enabled);
+	bool transient_backing(window);	///< Determines whether the transient backing of the widget is enabled.
+
+	/// Declares a widget translucent.
+	/**
+	 * A widget is opaque by default, the siblings and the parts of the parent which are wholly covered by it are not
+	 * refreshed and pasted when the parent is painted. A widget which shows the content under it, such as one which
+	 * copies the content of its parent in its drawer, should be declared translucent. The widgets which have a
+	 * bground effect are always translucent.
+	 * @param wd A handle to the widget.
+	 * @param enabled Indicates whether the widget is translucent.
+	 */
+	void translucent(window wd, bool enabled);
+	bool translucent(window);	///< Determines whether the widget is declared translucent.
+
+	/// Sets the budget of the graphics of all windows, in bytes.
+	/**
+	 * The widgets which are hidden, such as the pages of a tabbar or the collapsed fields of a place, keep their graphics.
+	 * When the graphics of all windows exceed the budget, the widgets which have been hidden longest release the graphics
+	 * of themselves and their descendants. The graphics are made and rendered again when the widgets are shown.
+	 * @param bytes The budget, zero means unlimited, it is the default.
+	 */
+	void backing_store_budget(std::size_t bytes);
+	std::size_t backing_store_budget();	///< Returns the budget of the graphics of all windows, zero if it is unlimited.
+
+	/// Sets the time for which a widget is hidden before it releases the graphics of itself and its descendants.
+	/**
+	 * The expired widgets are released when a window is shown, hidden or updated.
+	 * @param threshold The time, zero disables the releasing by time, it is the default.
+	 */
+	void backing_store_threshold(std::chrono::milliseconds threshold);
+	std::chrono::milliseconds backing_store_threshold();
+
+	std::size_t backing_store_usage();	///< Returns the number of bytes of the graphics of all windows.
+
+	/// Sets the frame rate of the root window to which the specified window belongs.
+	/**
+	 * When the frame rate is not zero, the updates of the windows are accumulated and copied to the screen
+	 * at most once per frame. It should be called in the thread which created the window.
+	 * @param wd A handle to the window.
+	 * @param hz The number of frames per second. Zero disables the frame pacing, it is the default.
+	 */
+	void frame_rate(window wd, unsigned hz);
+	unsigned frame_rate(window);			///< Returns the frame rate of the root window, zero if the frame pacing is disabled.
+
+	/// Refreshes the window and displays it in next frame. It is equivalent to refresh_window() if the frame pacing is disabled.
+	void request_frame(window);
+	frame_statistics frame_stats(window);	///< Returns the statistics of the frame pacing of the root window.
+
+	/// The latencies of the event processing, they are measured when NANA_ENABLE_EVENT_PROFILING is defined.
+	namespace profiling
+	{
+		bool enabled();	///< Determines whether the event profiling is compiled into the library.
+
+		/// Returns the histogram of the latencies of an event phase.
+		/**
+		 * The time of a phase excludes the time of the events which are emitted during the phase,
+		 * so that a slow handler is accounted to the event which really invoked it.
+		 */
+		latency_histogram latency(event_code, event_phase);
+
+		void reset();	///< Clears all the histograms.
+
+		/// Writes a summary of the histograms which have samples.
+		void dump(std::ostream&);
+
+		/// Writes a summary of the histograms to a file. Returns false if the file can't be opened.
+		bool dump(const std::string& file_utf8);
+	}
+
 	void window_caption(window, const std::string& title_utf8);
 	void window_caption(window, const std::wstring& title);
 	::std::string window_caption(window);
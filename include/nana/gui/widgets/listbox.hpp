@@ -27,6 +27,8 @@
 #include <nana/pat/abstract_factory.hpp>
 #include <nana/concepts.hpp>
 #include <nana/key_type.hpp>
+#include <chrono>
+#include <deque>
 #include <functional>
 #include <initializer_list>
 #include <mutex>
@@ -650,6 +652,108 @@ namespace nana
 				std::unique_ptr<container_interface> container_ptr_;
 			};
 
+			/// The queue of the operations which are fed to the model of a category.
+			class model_feed
+			{
+			public:
+				enum class kinds
+				{
+					insert, update, erase
+				};
+
+				/// Modifies the container of the model at the specified position, it's called in the GUI thread while the model is locked.
+				using modifier = std::function<void(model_guard&, std::size_t pos)>;
+
+				struct operation
+				{
+					kinds kind;
+					std::size_t pos;
+					modifier modify;
+				};
+
+				/// Queues an operation, it's thread-safe.
+				void push(kinds, std::size_t pos, modifier);
+
+				/// Takes the operation which was queued first, returns false if the queue is empty. It's thread-safe.
+				bool pop(operation&);
+
+				/// Returns the number of the queued operations, it's thread-safe.
+				std::size_t pending();
+
+				/// Returns the token which is shared by the feeders, it's called in the GUI thread.
+				std::shared_ptr<void> token();
+
+				/// Determines whether a feeder still exists, it's called in the GUI thread.
+				bool feeding() const;
+			private:
+				std::mutex mutex_;
+				std::deque<operation> operations_;
+				std::weak_ptr<void> token_;
+			};
+
+			/// Feeds the model of a category from any thread.
+			/**
+			 * The operations are queued, and the listbox applies them to the container of the model in batches in the GUI thread,
+			 * so that a producer thread doesn't wait for the GUI. A position refers to the container when the operation is applied,
+			 * an insertion beyond the end appends the value, an update or erasure beyond the end is ignored.
+			 * The operations are discarded if the category is removed or its model is replaced. The listbox stops applying
+			 * the operations when all the feeders of the category are destroyed.
+			 */
+			template<typename STLContainer>
+			class model_feeder
+			{
+				using value_type = typename STLContainer::value_type;
+			public:
+				explicit model_feeder(const std::shared_ptr<model_feed>& feed)
+					: feed_(feed), token_(feed->token())
+				{}
+
+				/// Inserts a value before the specified position, returns false if the operation is discarded.
+				bool insert(std::size_t pos, value_type value)
+				{
+					return _m_push(model_feed::kinds::insert, pos, [value](model_guard& guard, std::size_t pos) mutable {
+						auto & cont = guard.container<STLContainer>();
+						auto i = cont.begin();
+						std::advance(i, pos);
+						cont.insert(i, std::move(value));
+					});
+				}
+
+				bool push_back(value_type value)
+				{
+					return insert(npos, std::move(value));
+				}
+
+				/// Replaces the value at the specified position, returns false if the operation is discarded.
+				bool update(std::size_t pos, value_type value)
+				{
+					return _m_push(model_feed::kinds::update, pos, [value](model_guard& guard, std::size_t pos) mutable {
+						auto & cont = guard.container<STLContainer>();
+						auto i = cont.begin();
+						std::advance(i, pos);
+						*i = std::move(value);
+					});
+				}
+
+				/// Erases the value at the specified position, returns false if the operation is discarded.
+				bool erase(std::size_t pos)
+				{
+					return _m_push(model_feed::kinds::erase, pos, nullptr);
+				}
+			private:
+				bool _m_push(model_feed::kinds kind, std::size_t pos, model_feed::modifier modify)
+				{
+					auto feed = feed_.lock();
+					if (feed)
+						feed->push(kind, pos, std::move(modify));
+
+					return (nullptr != feed);
+				}
+			private:
+				std::weak_ptr<model_feed> feed_;
+				std::shared_ptr<void> token_;	///< Keeps the listbox applying the operations.
+			};
+
 
 			/// useful for both absolute and display (sorted) positions
 			struct index_pair
@@ -1036,6 +1140,49 @@ namespace nana
 					_m_update();
 				}
 
+				/// Appends the items of a range at the end of this category using the oresolver to generate the texts of each item.
+				/**
+				 * The items are appended under one lock, they are placed in the sort order together and the listbox is refreshed once.
+				 * If the listbox has a model set, try call append_model instead.
+				 */
+				template<typename InputIterator>
+				void append_range(InputIterator first, InputIterator last)
+				{
+					std::vector<std::vector<cell>> rows;
+					for (; first != last; ++first)
+					{
+						oresolver ores(ess_);
+
+						//Troubleshoot:
+						//If a compiler error that no operator<< overload found for type T occurs, please define a overload operator<<(oresolver&, const T&).
+						ores << *first;
+						rows.emplace_back(ores.move_cells());
+					}
+
+					append_range(std::move(rows));
+				}
+
+				/// Appends the items at the end of this category with the specified cells, the cells are moved into the items.
+				void append_range(std::vector<std::vector<cell>>&& rows);
+
+				/// Reserves the storage for the specified number of items, it's used before a large number of items are appended.
+				void reserve(size_type items);
+
+				/// Displays the items whose texts of the column contain the query, the other items are hidden.
+				/**
+				 * The ASCII letters are compared case-insensitively unless case_sensitive is true. If the query extends the previous
+				 * query of the same column, only the displayed items are tested again. The items which are appended or modified through
+				 * the listbox are tested as well, but the items which are modified through the model_guard are not tested until the filter
+				 * is set again. An empty query removes the filter.
+				 */
+				void filter(size_type column, std::string query, bool case_sensitive = false);
+
+				/// Displays the items which the predicate returns true for, an empty predicate removes the filter.
+				void filter(std::function<bool(const item_proxy&)> pred);
+
+				/// Removes the filter, all items are displayed.
+				void unfilter();
+
 				template<typename Mutex, typename STLContainer, typename ValueTranslator, typename CellTranslator>
 				void model(STLContainer&& container, ValueTranslator vtrans, CellTranslator ctrans)
 				{
@@ -1056,6 +1203,35 @@ namespace nana
 
 				model_guard model();
 
+				/// Returns a feeder which queues the modifications of the shared model from any thread.
+				/**
+				 * The feeder is made in the GUI thread, and it can be copied to the producer threads. The queued operations are
+				 * applied at most once an interval, see listbox::feed_interval. The items which are updated are drawn again
+				 * if they are displayed, the listbox is drawn again if the items are inserted, erased or moved.
+				 */
+				template<typename STLContainer>
+				model_feeder<typename std::decay<STLContainer>::type> feeder()
+				{
+					using stlcontainer = typename std::decay<STLContainer>::type;
+
+					//Throws if the category doesn't have a mutable model of the container type.
+					model().container<stlcontainer>();
+					return model_feeder<stlcontainer>{ _m_feed() };
+				}
+
+				/// Makes the category virtual, the listbox doesn't store an object for each item of the category.
+				/**
+				 * The cells of an item are fetched when the item is displayed, sorted or exported, and the selected and checked
+				 * states are stored by ranges. A virtual category is immutable, its items can't be inserted, erased or modified
+				 * through the listbox, the number of items is changed by virtual_size().
+				 * @param rows The number of items.
+				 * @param fetcher Returns the cells of an item specified by absolute position, it is called in the GUI thread.
+				 */
+				void virtual_model(size_type rows, std::function<std::vector<cell>(size_type pos)> fetcher);
+
+				/// Changes the number of items of a virtual category, the states of the removed items are discarded.
+				void virtual_size(size_type rows);
+
 				/// Appends one item at the end of this category with the specifies texts in the column fields
 				void append(std::initializer_list<std::string> texts_utf8);
 				void append(std::initializer_list<std::wstring> texts);
@@ -1142,6 +1318,7 @@ namespace nana
 				void _m_cat_by_pos() noexcept;
 				void _m_update() noexcept;
 				void _m_reset_model(model_interface*);
+				std::shared_ptr<model_feed> _m_feed();
 			private:
 				essence*	ess_{nullptr};
 				category_t*	cat_{nullptr};
@@ -1182,6 +1359,16 @@ namespace nana
 		arg_listbox_category(const drawerbase::listbox::cat_proxy&) noexcept;
 	};
 
+	/// The event parameter type for listbox's bulk_selected
+	struct arg_listbox_bulk
+		: public event_arg
+	{
+		drawerbase::listbox::cat_proxy category;
+		bool selected;	///< Indicates whether the items are selected or deselected.
+
+		arg_listbox_bulk(const drawerbase::listbox::cat_proxy&, bool selected) noexcept;
+	};
+
 	namespace drawerbase
 	{
 		namespace listbox
@@ -1197,6 +1384,10 @@ namespace nana
 
 				/// An event occurs when a listbox category is double clicking.
 				basic_event<arg_listbox_category> category_dbl_click;
+
+				/// An event occurs when the items of a virtual category are selected or deselected at once, such as by selecting
+				/// all items. The selected event is not emitted for each item of the category.
+				basic_event<arg_listbox_bulk> bulk_selected;
 			};
 
 			struct scheme
@@ -1409,6 +1600,9 @@ the nana::detail::basic_window member pointer scheme
 
 		void auto_draw(bool) noexcept;		///< Set state: Redraw automatically after an operation
 
+		/// Sets the interval at which the operations queued by the model feeders are applied, the default is 40 milliseconds.
+		void feed_interval(std::chrono::milliseconds);
+
 		template<typename Function>
 		void avoid_drawing(Function fn)
 		{
@@ -1542,6 +1736,19 @@ the nana::detail::basic_window member pointer scheme
 		void unsort();
 		bool freeze_sort(bool freeze);
 
+		/// Displays the items whose texts of the column contain the query in all categories, an empty query removes the filters.
+		/**
+		 * The ASCII letters are compared case-insensitively unless case_sensitive is true. If the query extends the previous
+		 * query of the same column, only the displayed items are tested again. The display positions refer to the displayed items only.
+		 */
+		void filter(size_type col, std::string query, bool case_sensitive = false);
+
+		/// Displays the items which the predicate returns true for in all categories.
+		void filter(std::function<bool(const item_proxy&)> pred);
+
+		/// Removes the filters, all items are displayed.
+		void unfilter();
+
 		index_pairs selected() const;		///<Get the absolute indexs of all the selected items
 
 		void show_header(bool);
@@ -227,6 +227,9 @@ namespace nana
 
 			void gradual_rectangle(const ::nana::rectangle&, const color& from, const color& to, bool vertical);
 			void round_rectangle(const ::nana::rectangle&, unsigned radius_x, unsigned radius_y, const color&, bool solid, const color& color_if_solid);
+		private:
+			/// Creates a graphics whose pixmap is at least the capacity, the capacity is ignored under Windows.
+			void _m_make(const ::nana::size& sz, const ::nana::size& capacity);
 		private:
 			struct implementation;
 			std::unique_ptr<implementation> impl_;
@@ -67,8 +67,12 @@ namespace detail
 	{
 		using font_type = ::std::shared_ptr<font_interface>;
 
-		Pixmap	pixmap;
-		GC	context;
+		int depth{0};	///< The depth which the pixmap and the GC are created for.
+		Pixmap	pixmap{0};
+		GC	context{nullptr};
+
+		nana::size	size;		///< The size of the graphics.
+		nana::size	capacity;	///< The size of the pixmap, it may be larger than the graphics, see graphics::resize.
 
 		font_type font;
 
@@ -31,6 +31,25 @@ appearance::appearance(bool has_decorate, bool taskbar, bool is_float, bool no_a
 {}
 //end struct appearance
 
+//struct latency_histogram
+std::chrono::microseconds latency_histogram::percentile(double ratio) const
+{
+	if (0 == samples)
+		return std::chrono::microseconds{ 0 };
+
+	auto const threshold = static_cast<double>(samples) * ratio;
+
+	std::size_t accumulated = 0;
+	for (std::size_t i = 0; i < bucket_count; ++i)
+	{
+		accumulated += buckets[i];
+		if (accumulated >= threshold)
+			return (i + 1 < bucket_count ? std::chrono::microseconds{ 1ll << i } : max);
+	}
+	return max;
+}
+//end struct latency_histogram
+
 #if defined(NANA_WINDOWS)
 #	include <windows.h>
 #endif
@@ -0,0 +1,218 @@
+/*
+ *	Backing Store Collector Implementation
+ *	Nana C++ Library(http://www.nanapro.org)
+ *	Copyright(C) 2003-2019 Jinhao(cnjinhao@hotmail.com)
+ *
+ *	Distributed under the Boost Software License, Version 1.0.
+ *	(See accompanying file LICENSE_1_0.txt or copy at
+ *	http://www.boost.org/LICENSE_1_0.txt)
+ *
+ *	@file: nana/gui/detail/backing_store.cpp
+ */
+
+#include "backing_store.hpp"
+#include "basic_window.hpp"
+#include <algorithm>
+
+namespace nana
+{
+	namespace detail
+	{
+		namespace
+		{
+			std::size_t bytes_of(const basic_window* wd)
+			{
+				if ((category::flags::lite_widget == wd->other.category) || wd->drawer.graphics.empty())
+					return 0;
+
+				auto sz = wd->drawer.graphics.size();
+				return static_cast<std::size_t>(sz.width) * sz.height * 4;
+			}
+
+			std::size_t usage_of(const basic_window* wd)
+			{
+				auto bytes = bytes_of(wd);
+				for (auto child : wd->children)
+				{
+					//A nested root window is measured as a root
+					if (category::flags::root != child->other.category)
+						bytes += usage_of(child);
+				}
+				return bytes;
+			}
+
+			//Releases the graphics of a widget and its descendants, returns the number of the released bytes.
+			std::size_t release_tree(basic_window* wd)
+			{
+				std::size_t bytes = 0;
+
+				//The graphics of a widget with bground effect keeps the background, it can't be rendered again by its drawer.
+				//The transient widgets release the graphics by themselves.
+				if ((category::flags::widget == wd->other.category) && (nullptr == wd->effect.bground) &&
+					!(wd->flags.transient_backing || wd->flags.refreshing || wd->drawer.graphics.empty()))
+				{
+					bytes = bytes_of(wd);
+
+					//Keeps the font, it is used when the graphics is made again.
+					auto font = wd->drawer.graphics.typeface();
+					wd->drawer.graphics.release();
+					wd->drawer.graphics.typeface(font);
+					wd->flags.backing_released = true;
+				}
+
+				for (auto child : wd->children)
+				{
+					if (category::flags::root != child->other.category)
+						bytes += release_tree(child);
+				}
+				return bytes;
+			}
+
+			//Makes the released graphics of a widget and its visible descendants.
+			void restore_tree(basic_window* wd)
+			{
+				if (wd->flags.backing_released)
+				{
+					wd->flags.backing_released = false;
+					if (!wd->dimension.empty())
+						wd->drawer.graphics.make(wd->dimension);
+				}
+
+				for (auto child : wd->children)
+				{
+					//A hidden child is restored when it is shown.
+					if (child->visible && (category::flags::root != child->other.category))
+						restore_tree(child);
+				}
+			}
+		}
+
+		//class backing_store_collector
+		void backing_store_collector::budget(std::size_t bytes)
+		{
+			budget_ = bytes;
+		}
+
+		std::size_t backing_store_collector::budget() const
+		{
+			return budget_;
+		}
+
+		void backing_store_collector::threshold(std::chrono::milliseconds ms)
+		{
+			threshold_ = ms;
+		}
+
+		std::chrono::milliseconds backing_store_collector::threshold() const
+		{
+			return threshold_;
+		}
+
+		void backing_store_collector::transient(basic_window* wd, bool enabled)
+		{
+			auto i = std::find(transients_.begin(), transients_.end(), wd);
+			if (enabled && (i == transients_.end()))
+				transients_.push_back(wd);
+			else if ((!enabled) && (i != transients_.end()))
+				transients_.erase(i);
+		}
+
+		void backing_store_collector::visible(basic_window* wd, bool is_visible, const std::vector<basic_window*>& roots)
+		{
+			if (is_visible)
+			{
+				_m_erase_hidden(wd);
+
+				//The widget is still hidden if one of its ancestors is hidden, it's restored with the ancestor.
+				if (wd->visible_parents())
+					restore_tree(wd);
+			}
+			else if (budget_ || (threshold_.count() > 0))
+			{
+				_m_erase_hidden(wd);
+				hidden_.push_back(hidden_window{ wd, clock_type::now() });
+
+				if (budget_)
+					_m_enforce(roots);
+			}
+
+			expire();
+		}
+
+		void backing_store_collector::erase(basic_window* wd)
+		{
+			_m_erase_hidden(wd);
+			transient(wd, false);
+		}
+
+		void backing_store_collector::expire()
+		{
+			_m_release_idle();
+
+			if (hidden_.empty() || (threshold_.count() <= 0))
+				return;
+
+			auto const deadline = clock_type::now() - threshold_;
+
+			auto i = hidden_.begin();
+			for (; (i != hidden_.end()) && (i->since <= deadline); ++i)
+				release_tree(i->window);
+
+			hidden_.erase(hidden_.begin(), i);
+		}
+
+		std::size_t backing_store_collector::usage(const std::vector<basic_window*>& roots)
+		{
+			std::size_t bytes = 0;
+			for (auto root : roots)
+				bytes += usage_of(root);
+
+			return bytes;
+		}
+
+		void backing_store_collector::_m_enforce(const std::vector<basic_window*>& roots)
+		{
+			auto bytes = usage(roots);
+
+			auto i = hidden_.begin();
+			for (; (i != hidden_.end()) && (bytes > budget_); ++i)
+			{
+				auto released = release_tree(i->window);
+				bytes -= (std::min)(bytes, released);
+			}
+
+			hidden_.erase(hidden_.begin(), i);
+		}
+
+		void backing_store_collector::_m_erase_hidden(basic_window* wd)
+		{
+			auto i = std::find_if(hidden_.begin(), hidden_.end(), [wd](const hidden_window& hw){
+				return (hw.window == wd);
+			});
+
+			if (i != hidden_.end())
+				hidden_.erase(i);
+		}
+
+		void backing_store_collector::_m_release_idle()
+		{
+			if (transients_.empty())
+				return;
+
+			//The widgets are scanned at most twice in an idle time, rather than every time a window is updated.
+			auto const now = clock_type::now();
+			if (now - scanned_ < transient_idle_ / 2)
+				return;
+
+			scanned_ = now;
+
+			auto const deadline = now - transient_idle_;
+			for (auto wd : transients_)
+			{
+				if (wd->drawer.transient_used() <= deadline)
+					wd->drawer.release_transient();
+			}
+		}
+		//end class backing_store_collector
+	}//end namespace detail
+}//end namespace nana
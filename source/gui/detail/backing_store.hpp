@@ -0,0 +1,97 @@
+/*
+ *	Backing Store Collector Implementation
+ *	Nana C++ Library(http://www.nanapro.org)
+ *	Copyright(C) 2003-2019 Jinhao(cnjinhao@hotmail.com)
+ *
+ *	Distributed under the Boost Software License, Version 1.0.
+ *	(See accompanying file LICENSE_1_0.txt or copy at
+ *	http://www.boost.org/LICENSE_1_0.txt)
+ *
+ *	@file: nana/gui/detail/backing_store.hpp
+ *
+ *	!DON'T INCLUDE THIS HEADER FILE IN YOUR SOURCE CODE
+ */
+
+#ifndef NANA_GUI_DETAIL_BACKING_STORE_HPP
+#define NANA_GUI_DETAIL_BACKING_STORE_HPP
+
+#include <nana/push_ignore_diagnostic>
+#include <chrono>
+#include <vector>
+
+namespace nana{
+	namespace detail
+	{
+		struct basic_window;
+
+		/// Releases the graphics of the hidden widgets.
+		/**
+		 * A widget which has been hidden for longer than the threshold releases the graphics of itself and its descendants,
+		 * and the widgets which have been hidden longest are released first when the graphics of all windows exceed the budget.
+		 * The released graphics are made again when the widget is shown, and they are rendered by the expose.
+		 * The graphics of a widget with transient backing is released when the widget has been idle, neither painted nor
+		 * handling an event, for longer than the transient idle time.
+		 * There is no timer, the expired widgets are released when a window is shown, hidden or updated.
+		 */
+		class backing_store_collector
+		{
+		public:
+			using clock_type = std::chrono::steady_clock;
+
+			/// Sets the budget of the graphics of the windows in bytes, zero means unlimited.
+			void budget(std::size_t bytes);
+			std::size_t budget() const;
+
+			/// Sets the time for which a widget is hidden before its graphics is released, zero disables the expiration.
+			void threshold(std::chrono::milliseconds);
+			std::chrono::milliseconds threshold() const;
+
+			/// Records a widget whose transient backing is enabled or disabled.
+			void transient(basic_window*, bool enabled);
+
+			/// Records a widget which is to be shown or hidden, it's called before the visibility is changed.
+			/**
+			 * When a widget is to be shown, the released graphics of it and its visible descendants are made again.
+			 * @param roots The root windows, they are used for measuring the usage when a widget is hidden.
+			 */
+			void visible(basic_window*, bool is_visible, const std::vector<basic_window*>& roots);
+
+			/// Removes a widget which is being destroyed.
+			void erase(basic_window*);
+
+			/// Releases the widgets which have been hidden for longer than the threshold, and the idle widgets with transient backing.
+			void expire();
+
+			/// Returns the number of bytes of the graphics of the windows.
+			static std::size_t usage(const std::vector<basic_window*>& roots);
+		private:
+			/// Releases the hidden widgets from the longest hidden until the usage is within the budget.
+			void _m_enforce(const std::vector<basic_window*>& roots);
+
+			void _m_erase_hidden(basic_window*);
+
+			/// Releases the graphics of the widgets with transient backing which have been idle for longer than the idle time.
+			void _m_release_idle();
+		private:
+			struct hidden_window
+			{
+				basic_window* window;
+				clock_type::time_point since;
+			};
+
+			std::size_t budget_{ 0 };
+			std::chrono::milliseconds threshold_{ 0 };
+
+			std::vector<hidden_window> hidden_;	///< Ordered by the time the widgets were hidden.
+
+			/// The time for which a widget with transient backing is idle before its graphics is released.
+			std::chrono::milliseconds const transient_idle_{ 1000 };
+			std::vector<basic_window*> transients_;	///< The widgets with transient backing.
+			clock_type::time_point scanned_;	///< The time when the widgets with transient backing were scanned last.
+		};
+	}
+}//end namespace nana
+
+#include <nana/pop_ignore_diagnostic>
+
+#endif
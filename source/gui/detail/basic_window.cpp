@@ -339,7 +339,8 @@ namespace nana
 
 			bool basic_window::try_lazy_update(bool try_refresh)
 			{
-				if (drawer.graphics.empty())
+				//A widget with transient backing has an empty graphics between the paints
+				if (drawer.graphics.empty() && !flags.transient_backing)
 					return true;
 
 				if (!this->root_widget->other.attribute.root->lazy_update)
@@ -427,6 +428,11 @@ namespace nana
 				flags.ignore_menubar_focus	= false;
 				flags.ignore_mouse_focus	= false;
 				flags.space_click_enabled = false;
+				flags.transient_backing = false;
+				flags.backing_released = false;
+				flags.bground_damaged = false;
+				flags.translucent = false;
+				flags.refresh_deferred = false;
 
 				visible = false;
 
@@ -94,6 +94,7 @@ namespace detail
 		{
 			basic_window * window;
 			bool rendered;
+			rectangle area;	///< The outer rectangle of the rendered nimbus.
 		};
 
 		/// constructor for the root window
@@ -179,7 +180,12 @@ namespace detail
 			bool ignore_mouse_focus		: 1;	///< A flag indicates whether the widget accepts focus when clicking on it
 			bool space_click_enabled : 1;		///< A flag indicates whether enable mouse_down/click/mouse_up when pressing and releasing whitespace key.
 			bool draggable : 1;
-			unsigned Reserved : 17;
+			bool transient_backing : 1;	///< The graphics is released after the widget is copied to the root graphics.
+			bool backing_released : 1;	///< The graphics is released while the widget is hidden, it's made again when the widget is shown.
+			bool bground_damaged : 1;	///< The background under a glass window is changed, the glass buffer is made again by next paint.
+			bool translucent : 1;		///< The widget doesn't occlude the siblings under it, see API::translucent.
+			bool refresh_deferred : 1;	///< A refresh is skipped while the widget is occluded, it's refreshed when it is painted next time.
+			unsigned Reserved : 12;
 			unsigned char tab;		///< indicate a window that can receive the keyboard TAB
 			mouse_action	action;
 			mouse_action	action_before;
@@ -211,6 +217,11 @@ namespace detail
 				bool lazy_update{ false };	///< Indicates whether the window is in lazy-updating mode.
 
 				container	update_requesters;	///< Container for lazy-updating requesting windows.
+
+				unsigned	geometry_batch{ 0 };			///< The depth of the geometry batches, see API::geometry_batch.
+				bool		lazy_update_before_batch{ false };
+				bool		merge_requesters{ false };		///< The requesters are copied to the screen by the union of them, it's set by a geometry batch.
+				std::vector<std::pair<basic_window*, bool>> batch_resized;	///< The resized windows whose events are deferred, and whether to ask update.
 				container	tabstop;
 				std::vector<edge_nimbus_action> effects_edge_nimbus;
 				basic_window*	focus{nullptr};
@@ -13,6 +13,7 @@
 #include "../../detail/platform_spec_selector.hpp"
 #include "basic_window.hpp"
 #include "bedrock_types.hpp"
+#include "event_profiler.hpp"
 #include <nana/gui/compact.hpp>
 #include <nana/gui/widgets/widget.hpp>
 #include <nana/gui/detail/event_code.hpp>
@@ -40,6 +41,18 @@ namespace nana
 		}
 	//end class internal_scope_guard
 
+	//class internal_shared_guard
+		internal_shared_guard::internal_shared_guard()
+		{
+			detail::bedrock::instance().wd_manager().lock_shared();
+		}
+
+		internal_shared_guard::~internal_shared_guard()
+		{
+			detail::bedrock::instance().wd_manager().unlock_shared();
+		}
+	//end class internal_shared_guard
+
 	//class internal_revert_guard
 		internal_revert_guard::internal_revert_guard()
 		{
@@ -74,8 +87,8 @@ namespace nana
 		class bedrock::flag_guard
 		{
 		public:
-			flag_guard(bedrock* brock, basic_window * wd)
-				: brock_{ brock }, wd_(wd)
+			flag_guard(bedrock* brock, basic_window * wd, event_code evt_code)
+				: brock_{ brock }, wd_(wd), probe_(evt_code, event_phase::refresh, wd)
 			{
 				wd_->flags.refreshing = true;
 			}
@@ -88,6 +101,7 @@ namespace nana
 		private:
 			bedrock			*const brock_;
 			basic_window	*const wd_;
+			latency_probe	probe_;
 		};
 
 		//class root_guard
@@ -409,7 +423,7 @@ namespace nana
 					{
 						{
 							//enable refreshing flag, this is a RAII class for exception-safe
-							flag_guard fguard(this, wd);
+							flag_guard fguard(this, wd, evt_code);
 							wd->drawer.click(*arg, bForce__EmitInternal);
 						}
 						if (bProcess__External_event)
@@ -463,7 +477,7 @@ namespace nana
 
 				{
 					//enable refreshing flag, this is a RAII class for exception-safe
-					flag_guard fguard(this, wd);
+					flag_guard fguard(this, wd, evt_code);
 					(wd->drawer.*drawer_event_fn)(*arg, bForce__EmitInternal);
 				}
 
@@ -478,7 +492,7 @@ namespace nana
 				{
 					{
 						//enable refreshing flag, this is a RAII class for exception-safe
-						flag_guard fguard(this, wd);
+						flag_guard fguard(this, wd, evt_code);
 						wd->drawer.mouse_wheel(*arg, bForce__EmitInternal);
 					}
 
@@ -522,7 +536,7 @@ namespace nana
 				}
 				{
 					//enable refreshing flag, this is a RAII class for exception-safe
-					flag_guard fguard(this, wd);
+					flag_guard fguard(this, wd, evt_code);
 					(wd->drawer.*drawer_event_fn)(*arg, bForce__EmitInternal);
 				}
 
@@ -545,7 +559,7 @@ namespace nana
 				{
 					{
 						//enable refreshing flag, this is a RAII class for exception-safe
-						flag_guard fguard(this, wd);
+						flag_guard fguard(this, wd, evt_code);
 						wd->drawer.focus(*arg, bForce__EmitInternal);
 					}
 					if (bProcess__External_event)
@@ -560,7 +574,7 @@ namespace nana
 				{
 					{
 						//enable refreshing flag, this is a RAII class for exception-safe
-						flag_guard fguard(this, wd);
+						flag_guard fguard(this, wd, evt_code);
 						wd->drawer.move(*arg, bForce__EmitInternal);
 					}
 					if (bProcess__External_event)
@@ -575,7 +589,7 @@ namespace nana
 				{
 					{
 						//enable refreshing flag, this is a RAII class for exception-safe
-						flag_guard fguard(this, wd);
+						flag_guard fguard(this, wd, evt_code);
 						wd->drawer.resizing(*arg, bForce__EmitInternal);
 					}
 					if (bProcess__External_event)
@@ -590,7 +604,7 @@ namespace nana
 				{
 					{
 						//enable refreshing flag, this is a RAII class for exception-safe
-						flag_guard fguard(this, wd);
+						flag_guard fguard(this, wd, evt_code);
 						wd->drawer.resized(*arg, bForce__EmitInternal);
 					}
 					if (bProcess__External_event)
@@ -655,7 +669,11 @@ namespace nana
 			if (update_state::none == wd->other.upd_state)
 				wd->other.upd_state = update_state::lazy;
 
-			_m_emit_core(evt_code, wd, false, arg, bForce__EmitInternal);
+			{
+				//The time of the drawer is measured by the flag_guard and excluded from the handler time.
+				latency_probe probe{ evt_code, event_phase::handler, wd };
+				_m_emit_core(evt_code, wd, false, arg, bForce__EmitInternal);
+			}
 
 			bool good_wd = false;
 			if(wd_manager().available(wd))
@@ -664,6 +682,7 @@ namespace nana
 				//so refresh all children of wd when a resized occurs.
 				if(ask_update || (event_code::resized == evt_code) || (update_state::refreshed == wd->other.upd_state))
 				{
+					latency_probe probe{ evt_code, event_phase::flush, wd };
 					wd_manager().do_lazy_refresh(wd, false, (event_code::resized == evt_code));
 				}
 				else
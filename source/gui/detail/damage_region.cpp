@@ -0,0 +1,125 @@
+/*
+ *	Damage Region Implementation
+ *	Nana C++ Library(http://www.nanapro.org)
+ *	Copyright(C) 2003-2019 Jinhao(cnjinhao@hotmail.com)
+ *
+ *	Distributed under the Boost Software License, Version 1.0.
+ *	(See accompanying file LICENSE_1_0.txt or copy at
+ *	http://www.boost.org/LICENSE_1_0.txt)
+ *
+ *	@file: nana/gui/detail/damage_region.cpp
+ */
+
+#include "damage_region.hpp"
+#include <nana/gui/layout_utility.hpp>
+#include <algorithm>
+
+namespace nana
+{
+	namespace detail
+	{
+		namespace
+		{
+			std::size_t area_of(const rectangle& r)
+			{
+				return static_cast<std::size_t>(r.width) * r.height;
+			}
+
+			//Returns the smallest rectangle which contains both a and b
+			rectangle merge_area(const rectangle& a, const rectangle& b)
+			{
+				auto const left = (std::min)(a.x, b.x);
+				auto const top = (std::min)(a.y, b.y);
+				auto const right = (std::max)(a.right(), b.right());
+				auto const bottom = (std::max)(a.bottom(), b.bottom());
+
+				return rectangle{ left, top, static_cast<unsigned>(right - left), static_cast<unsigned>(bottom - top) };
+			}
+
+			//Returns the number of pixels which are copied needlessly if a and b are merged.
+			std::size_t waste_of(const rectangle& a, const rectangle& b)
+			{
+				rectangle ovlp;
+				auto const covered = area_of(a) + area_of(b) - (overlap(a, b, ovlp) ? area_of(ovlp) : 0);
+				return area_of(merge_area(a, b)) - covered;
+			}
+		}
+
+		//class damage_region
+		void damage_region::add(const rectangle& r)
+		{
+			if (r.empty())
+				return;
+
+			auto merged = r;
+			for (auto i = rects_.begin(); i != rects_.end();)
+			{
+				if (covered(merged, *i))
+					return;
+
+				if (waste_of(*i, merged) <= copy_cost)
+				{
+					//The merged rectangle may be worth merging with the rectangles which have been checked
+					merged = merge_area(*i, merged);
+					rects_.erase(i);
+					i = rects_.begin();
+					continue;
+				}
+				++i;
+			}
+
+			rects_.push_back(merged);
+
+			if (rects_.size() <= max_rectangles)
+				return;
+
+			//Merges the pair which wastes the fewest pixels
+			std::size_t first = 0, second = 1;
+			auto least = waste_of(rects_[0], rects_[1]);
+			for (std::size_t u = 0; u < rects_.size(); ++u)
+			{
+				for (std::size_t v = u + 1; v < rects_.size(); ++v)
+				{
+					auto waste = waste_of(rects_[u], rects_[v]);
+					if (waste < least)
+					{
+						least = waste;
+						first = u;
+						second = v;
+					}
+				}
+			}
+
+			rects_[first] = merge_area(rects_[first], rects_[second]);
+			rects_.erase(rects_.begin() + second);
+		}
+
+		bool damage_region::empty() const
+		{
+			return rects_.empty();
+		}
+
+		void damage_region::clear()
+		{
+			rects_.clear();
+		}
+
+		const std::vector<rectangle>& damage_region::rectangles() const
+		{
+			return rects_;
+		}
+
+		rectangle damage_region::bounds() const
+		{
+			if (rects_.empty())
+				return{};
+
+			auto r = rects_.front();
+			for (auto & rt : rects_)
+				r = merge_area(r, rt);
+
+			return r;
+		}
+		//end class damage_region
+	}//end namespace detail
+}//end namespace nana
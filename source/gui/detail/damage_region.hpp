@@ -0,0 +1,57 @@
+/*
+ *	Damage Region Implementation
+ *	Nana C++ Library(http://www.nanapro.org)
+ *	Copyright(C) 2003-2019 Jinhao(cnjinhao@hotmail.com)
+ *
+ *	Distributed under the Boost Software License, Version 1.0.
+ *	(See accompanying file LICENSE_1_0.txt or copy at
+ *	http://www.boost.org/LICENSE_1_0.txt)
+ *
+ *	@file: nana/gui/detail/damage_region.hpp
+ *
+ *	!DON'T INCLUDE THIS HEADER FILE IN YOUR SOURCE CODE
+ */
+
+#ifndef NANA_GUI_DETAIL_DAMAGE_REGION_HPP
+#define NANA_GUI_DETAIL_DAMAGE_REGION_HPP
+
+#include <nana/push_ignore_diagnostic>
+#include <nana/basic_types.hpp>
+#include <vector>
+
+namespace nana{
+	namespace detail
+	{
+		/// A list of damaged rectangles which are to be copied to the screen.
+		/**
+		 * Two rectangles are merged into their bounding rectangle if the pixels which are copied needlessly
+		 * cost less than a copy operation. The number of rectangles is limited, when the limit is exceeded,
+		 * the pair which wastes the fewest pixels is merged.
+		 */
+		class damage_region
+		{
+		public:
+			/// The maximum number of the rectangles.
+			static constexpr std::size_t max_rectangles = 16;
+
+			/// The cost of a copy operation, in pixels.
+			static constexpr std::size_t copy_cost = 32 * 32;
+
+			void add(const rectangle&);
+
+			bool empty() const;
+			void clear();
+
+			const std::vector<rectangle>& rectangles() const;
+
+			/// Returns the smallest rectangle which contains all the damaged rectangles.
+			rectangle bounds() const;
+		private:
+			std::vector<rectangle> rects_;
+		};
+	}
+}//end namespace nana
+
+#include <nana/pop_ignore_diagnostic>
+
+#endif
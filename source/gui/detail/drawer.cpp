@@ -16,6 +16,7 @@
 #include <nana/gui/detail/bedrock.hpp>
 #include <nana/gui/detail/drawer.hpp>
 #include "dynamic_drawing_object.hpp"
+#include <nana/paint/detail/native_paint_interface.hpp>
 
 #if defined(NANA_X11)
 	#include "../../detail/posix/platform_spec.hpp"
@@ -224,6 +225,7 @@ namespace nana
 			bool			refreshing{ false };
 			basic_window*	window_handle{ nullptr };
 			drawer_trigger*	realizer{ nullptr };
+			std::chrono::steady_clock::time_point	transient_used;
 			method_state	mth_state[event_size];
 			std::vector<dynamic_drawing::object*>	draws;
 		};
@@ -372,6 +374,14 @@ namespace nana
 
 		void drawer::refresh()
 		{
+			auto wd = data_impl_->window_handle;
+			if (wd && wd->flags.transient_backing)
+			{
+				data_impl_->transient_used = std::chrono::steady_clock::now();
+				if (graphics.empty() && !wd->dimension.empty())
+					graphics.make(wd->dimension);
+			}
+
 			if (data_impl_->realizer && (!(data_impl_->refreshing || graphics.size().empty())))
 			{
 				data_impl_->refreshing = true;
@@ -382,6 +392,40 @@ namespace nana
 			}
 		}
 
+		bool drawer::acquire_transient()
+		{
+			auto wd = data_impl_->window_handle;
+			if (!(wd && wd->flags.transient_backing))
+				return false;
+
+			//The graphics is kept while the widget is in use, it's released by the backing store collector when the widget is idle.
+			data_impl_->transient_used = std::chrono::steady_clock::now();
+			if (!graphics.empty() || wd->dimension.empty())
+				return false;
+
+			//The content is not kept while the graphics is released, it is rendered again.
+			graphics.make(wd->dimension);
+			refresh();
+			return true;
+		}
+
+		void drawer::release_transient()
+		{
+			auto wd = data_impl_->window_handle;
+			if (wd && wd->flags.transient_backing && (!graphics.empty()) && !(data_impl_->refreshing || wd->flags.refreshing))
+			{
+				//Keeps the font, it is used when the graphics is made again.
+				auto font = graphics.typeface();
+				graphics.release();
+				graphics.typeface(font);
+			}
+		}
+
+		std::chrono::steady_clock::time_point drawer::transient_used() const
+		{
+			return data_impl_->transient_used;
+		}
+
 		drawer_trigger* drawer::realizer() const
 		{
 			return data_impl_->realizer;
@@ -494,14 +538,8 @@ namespace nana
 			{
 				if (i->window == wd)
 				{
-					auto pixels = weight();
-					rectangle r{ wd->pos_root, wd->dimension };
-					r.x -= static_cast<int>(pixels);
-					r.y -= static_cast<int>(pixels);
-					r.width += static_cast<unsigned>(pixels << 1);
-					r.height += static_cast<unsigned>(pixels << 1);
-
-					root_wd->root_graph->paste(root_wd->root, r, r.x, r.y);
+					if (i->rendered)
+						_m_erase_edge_nimbus(root_wd, i->area);
 
 					nimbus.erase(i);
 					break;
@@ -511,85 +549,53 @@ namespace nana
 
 		void edge_nimbus_renderer::render(basic_window* wd, bool forced, const rectangle* update_area)
 		{
-			bool copy_separately = true;
-			std::vector<std::pair<rectangle, basic_window*>> rd_set;
+			//The nimbus is out of the window, the window is copied separately and the nimbus
+			//is rendered only if the copy overwrites it.
+			rectangle copied;
+			bool const has_copied = window_layer::read_visual_rectangle(wd, copied) &&
+				((nullptr == update_area) || ::nana::overlap(*update_area, rectangle(copied), copied));
 
-			if (wd->root_widget->other.attribute.root->effects_edge_nimbus.size())
-			{
-				auto root_wd = wd->root_widget;
-
-				auto & nimbus = root_wd->other.attribute.root->effects_edge_nimbus;
+			if (has_copied)
+				wd->root_graph->paste(wd->root, copied, copied.x, copied.y);
 
-				auto focused = root_wd->other.attribute.root->focus;
-
-				const unsigned pixels = weight();
+			auto root_wd = wd->root_widget;
+			auto & nimbus = root_wd->other.attribute.root->effects_edge_nimbus;
+			if (nimbus.empty())
+				return;
 
-				auto graph = root_wd->root_graph;
+			auto focused = root_wd->other.attribute.root->focus;
 
-				nana::rectangle r;
-				for (auto & action : nimbus)
+			nana::rectangle visual;
+			for (auto & action : nimbus)
+			{
+				if (_m_edge_nimbus(action.window, focused) && window_layer::read_visual_rectangle(action.window, visual))
 				{
-					if (_m_edge_nimbus(action.window, focused) && window_layer::read_visual_rectangle(action.window, r))
-					{
-						if (action.window == wd)
-						{
-							if (update_area)
-								::nana::overlap(*update_area, rectangle(r), r);
-							copy_separately = false;
-						}
+					auto area = visual;
+					area.pare_off(-static_cast<int>(weight()));
 
-						//Avoiding duplicated rendering. If the window is declared to lazy refresh, it should be rendered.
-						if ((forced && (action.window == wd)) || (focused == action.window) || !action.rendered || (action.window->other.upd_state == basic_window::update_state::refreshed))
-						{
-							rd_set.emplace_back(r, action.window);
-							action.rendered = true;
-						}
-					}
-					else if (action.rendered)
+					if (action.rendered && (action.area != area))
 					{
+						//The window is moved or resized, the old nimbus is erased.
+						_m_erase_edge_nimbus(root_wd, action.area);
 						action.rendered = false;
-
-						if (action.window == wd)
-							copy_separately = false;
-
-						::nana::rectangle erase_r(
-							action.window->pos_root.x - static_cast<int>(pixels),
-							action.window->pos_root.y - static_cast<int>(pixels),
-							static_cast<unsigned>(action.window->dimension.width + (pixels << 1)),
-							static_cast<unsigned>(action.window->dimension.height + (pixels << 1))
-						);
-
-						graph->paste(root_wd->root, erase_r, erase_r.x, erase_r.y);
 					}
-				}
-			}
 
-			if (copy_separately)
-			{
-				rectangle vr;
-				if (window_layer::read_visual_rectangle(wd, vr))
-				{
-					if (update_area)
-						::nana::overlap(*update_area, rectangle(vr), vr);
-					wd->root_graph->paste(wd->root, vr, vr.x, vr.y);
+					//The copy which is inside the visual rectangle doesn't overwrite the nimbus. If the window is declared to lazy refresh, it should be rendered.
+					//The nimbus of the focused window is always rendered, it's the focus highlight and the window may paint over its border.
+					if ((!action.rendered) || (forced && (action.window == wd)) || (focused == action.window) ||
+						(has_copied && overlapped(copied, area) && !covered(copied, visual)) ||
+						(action.window->other.upd_state == basic_window::update_state::refreshed))
+					{
+						_m_render_edge_nimbus(action.window, area);
+						action.rendered = true;
+						action.area = area;
+					}
 				}
-			}
-
-			rectangle wd_r{ wd->pos_root, wd->dimension };
-			wd_r.pare_off(-static_cast<int>(this->weight()));
-			//Render
-			for (auto & rd : rd_set)
-			{
-				auto other_wd = rd.second;
-
-				if (other_wd != wd)
+				else if (action.rendered)
 				{
-					rectangle other_r{ other_wd->pos_root, other_wd->dimension };
-					other_r.pare_off(-static_cast<int>(this->weight()));
-					if (!overlapped(wd_r, other_r))
-						continue;
+					action.rendered = false;
+					_m_erase_edge_nimbus(root_wd, action.area);
 				}
-				_m_render_edge_nimbus(other_wd, rd.first);
 			}
 		}
 		
@@ -607,54 +613,97 @@ namespace nana
 			return false;
 		}
 
-		void edge_nimbus_renderer::_m_render_edge_nimbus(basic_window* wd, const nana::rectangle & visual)
+		unsigned edge_nimbus_renderer::_m_strips(const rectangle& area, const size& root_size, rectangle* strips) const
 		{
-			wd->flags.action_before = wd->flags.action;
+			auto const pixels = weight();
+			if ((area.width <= (pixels << 1)) || (area.height <= (pixels << 1)))
+				return 0;
+
+			const rectangle sides[4] = {
+				{ area.x, area.y, area.width, pixels },
+				{ area.x, area.bottom() - static_cast<int>(pixels), area.width, pixels },
+				{ area.x, area.y + static_cast<int>(pixels), pixels, area.height - (pixels << 1) },
+				{ area.right() - static_cast<int>(pixels), area.y + static_cast<int>(pixels), pixels, area.height - (pixels << 1) }
+			};
 
-			auto r = visual;
-			r.pare_off(-static_cast<int>(weight()));
-			rectangle good_r;
-			if (overlap(r, rectangle{ wd->root_graph->size() }, good_r))
+			unsigned count = 0;
+			for (auto & r : sides)
 			{
-				if ((good_r.x < wd->pos_root.x) || (good_r.y < wd->pos_root.y) ||
-					(good_r.right() > visual.right()) || (good_r.bottom() > visual.bottom()))
-				{
-					auto graph = wd->root_graph;
-					nana::paint::pixel_buffer pixbuf(graph->handle(), r);
+				if (::nana::overlap(r, rectangle{ root_size }, strips[count]))
+					++count;
+			}
+			return count;
+		}
+
+		void edge_nimbus_renderer::_m_erase_edge_nimbus(basic_window* root_wd, const rectangle& area)
+		{
+			rectangle strips[4];
+			auto const count = _m_strips(area, root_wd->root_graph->size(), strips);
+			for (unsigned i = 0; i < count; ++i)
+				root_wd->root_graph->paste(root_wd->root, strips[i], strips[i].x, strips[i].y);
+		}
 
-					pixel_argb_t px0, px1, px2, px3;
+		void edge_nimbus_renderer::_m_render_edge_nimbus(basic_window* wd, const nana::rectangle& area)
+		{
+			wd->flags.action_before = wd->flags.action;
 
-					px0 = pixbuf.pixel(0, 0);
-					px1 = pixbuf.pixel(r.width - 1, 0);
-					px2 = pixbuf.pixel(0, r.height - 1);
-					px3 = pixbuf.pixel(r.width - 1, r.height - 1);
+			auto const color = wd->annex.scheme->activated.get_color().px_color();
+			if (!glow_.outer_table)
+			{
+				//The outer line and the inner line of the nimbus are blended with the root graphics.
+				glow_.outer_table = paint::detail::alloc_fade_table(1 - 0.4);
+				glow_.inner_table = paint::detail::alloc_fade_table(1 - 0.95);
+				glow_.color.value = ~color.value;
+			}
 
-					good_r.x = good_r.y = 1;
-					good_r.width = r.width - 2;
-					good_r.height = r.height - 2;
-					pixbuf.rectangle(good_r, wd->annex.scheme->activated.get_color(), 0.95, false);
+			if (glow_.color.value != color.value)
+			{
+				glow_.color = color;
+				glow_.outer = paint::detail::fade_color_intermedia(color, glow_.outer_table.get());
+				glow_.inner = paint::detail::fade_color_intermedia(color, glow_.inner_table.get());
+			}
 
-					good_r.x = good_r.y = 0;
-					good_r.width = r.width;
-					good_r.height = r.height;
-					pixbuf.rectangle(good_r, wd->annex.scheme->activated.get_color(), 0.4, false);
+			auto graph = wd->root_graph;
 
-					pixbuf.pixel(0, 0, px0);
-					pixbuf.pixel(r.width - 1, 0, px1);
-					pixbuf.pixel(0, r.height - 1, px2);
-					pixbuf.pixel(r.width - 1, r.height - 1, px3);
+			rectangle strips[4];
+			auto const count = _m_strips(area, graph->size(), strips);
 
-					pixbuf.paste(wd->root, { r.x, r.y });
+			auto const right = static_cast<int>(area.width) - 1;
+			auto const bottom = static_cast<int>(area.height) - 1;
+			for (unsigned i = 0; i < count; ++i)
+			{
+				auto & strip = strips[i];
+				nana::paint::pixel_buffer pixbuf(graph->handle(), strip);
 
-					std::vector<typename window_layer::wd_rectangle> overlaps;
-					if (window_layer::read_overlaps(wd, visual, overlaps))
+				for (int y = 0; y < static_cast<int>(strip.height); ++y)
+				{
+					auto const ay = strip.y - area.y + y;
+					auto line = pixbuf.raw_ptr(y);
+					for (int x = 0; x < static_cast<int>(strip.width); ++x)
 					{
-						for (auto & wdr : overlaps)
-							graph->paste(wd->root, wdr.r, wdr.r.x, wdr.r.y);
+						auto const ax = strip.x - area.x + x;
+
+						//The outer line without its corners, like the rectangles whose corners are restored.
+						auto const outer_x = ((0 == ax) || (right == ax));
+						auto const outer_y = ((0 == ay) || (bottom == ay));
+						if (outer_x || outer_y)
+						{
+							if (!(outer_x && outer_y))
+								line[x] = paint::detail::fade_color_by_intermedia(line[x], glow_.outer, glow_.outer_table.get());
+							continue;
+						}
+
+						//The corners of the inner line are blended twice by the horizontal and vertical sides.
+						auto const inner_x = ((1 == ax) || (right - 1 == ax));
+						auto const inner_y = ((1 == ay) || (bottom - 1 == ay));
+						if (inner_x)
+							line[x] = paint::detail::fade_color_by_intermedia(line[x], glow_.inner, glow_.inner_table.get());
+						if (inner_y)
+							line[x] = paint::detail::fade_color_by_intermedia(line[x], glow_.inner, glow_.inner_table.get());
 					}
 				}
-				else
-					wd->root_graph->paste(wd->root, visual, visual.x, visual.y);
+
+				pixbuf.paste(wd->root, strip.position());
 			}
 		}
 
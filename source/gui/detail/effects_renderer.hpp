@@ -18,6 +18,7 @@
 #include <nana/paint/pixel_buffer.hpp>
 #include <nana/gui/layout_utility.hpp>
 #include <nana/gui/detail/window_layout.hpp>
+#include <memory>
 
 namespace nana{
 	namespace detail
@@ -44,7 +45,28 @@ namespace nana{
 			/// Determines whether the effect will be rendered for the given window.
 			static bool _m_edge_nimbus(basic_window * const wd, basic_window * const focused_wd);
 
-			void _m_render_edge_nimbus(basic_window* wd, const nana::rectangle & visual);
+			/// Returns the strips of a nimbus which are in the root graphics.
+			/**
+			 * @param area The outer rectangle of the nimbus.
+			 * @param strips The top, bottom, left and right strips, at most 4 rectangles.
+			 */
+			unsigned _m_strips(const rectangle& area, const size& root_size, rectangle* strips) const;
+
+			/// Restores the strips of a nimbus on the screen with the root graphics.
+			void _m_erase_edge_nimbus(basic_window* root_wd, const nana::rectangle& area);
+
+			/// Renders the strips of a nimbus, the window itself is not touched.
+			void _m_render_edge_nimbus(basic_window* wd, const nana::rectangle& area);
+		private:
+			/// The fade tables and the blended colors of the nimbus, they are made again only if the color is changed.
+			struct glow_cache
+			{
+				std::unique_ptr<unsigned char[]> outer_table;
+				std::unique_ptr<unsigned char[]> inner_table;
+				pixel_color_t color;
+				pixel_color_t outer;
+				pixel_color_t inner;
+			}glow_;
 		};
 	}
 }//end namespace nana
@@ -0,0 +1,160 @@
+/*
+ *	Event Profiler Implementation
+ *	Nana C++ Library(http://www.nanapro.org)
+ *	Copyright(C) 2003-2019 Jinhao(cnjinhao@hotmail.com)
+ *
+ *	Distributed under the Boost Software License, Version 1.0.
+ *	(See accompanying file LICENSE_1_0.txt or copy at
+ *	http://www.boost.org/LICENSE_1_0.txt)
+ *
+ *	@file: nana/gui/detail/event_profiler.cpp
+ */
+
+#include "event_profiler.hpp"
+
+#ifdef NANA_ENABLE_EVENT_PROFILING
+#include "basic_window.hpp"
+#include <nana/gui/detail/bedrock.hpp>
+#include <nana/gui/detail/window_manager.hpp>
+#include <nana/gui/widgets/widget.hpp>
+#include <typeinfo>
+
+namespace nana
+{
+	namespace detail
+	{
+		namespace
+		{
+			//The innermost probe of current thread
+			thread_local latency_probe* current_probe = nullptr;
+
+			std::size_t bucket_of(long long us)
+			{
+				std::size_t i = 0;
+				while ((us > 0) && (i + 1 < latency_histogram::bucket_count))
+				{
+					us >>= 1;
+					++i;
+				}
+				return i;
+			}
+		}
+
+		//class event_profiler
+		event_profiler::counters::counters()
+		{
+			for (auto & n : buckets)
+				n.store(0, std::memory_order_relaxed);
+		}
+
+		event_profiler& event_profiler::instance()
+		{
+			static event_profiler object;
+			return object;
+		}
+
+		void event_profiler::record(event_code evt_code, event_phase phase, basic_window* wd, clock_type::duration elapsed)
+		{
+			if (evt_code >= event_code::end || phase >= event_phase::end)
+				return;
+
+			auto & cnt = _m_counters(evt_code, phase);
+
+			auto const us = static_cast<long long>(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+
+			cnt.samples.fetch_add(1, std::memory_order_relaxed);
+			cnt.total.fetch_add(us, std::memory_order_relaxed);
+			cnt.buckets[bucket_of(us)].fetch_add(1, std::memory_order_relaxed);
+
+			auto prev_max = cnt.max.load(std::memory_order_relaxed);
+			while (us > prev_max)
+			{
+				if (cnt.max.compare_exchange_weak(prev_max, us, std::memory_order_relaxed))
+				{
+					//A new maximum is rare, it is cheap to look up the type of the widget here.
+					//The window may be destroyed by the event which is measured.
+					const char* type_name = nullptr;
+					if (bedrock::instance().wd_manager().available(wd) && wd->widget_notifier)
+					{
+						auto wdg = wd->widget_notifier->widget_ptr();
+						if (wdg)
+							type_name = typeid(*wdg).name();
+					}
+
+					std::lock_guard<std::mutex> lock(slowest_mutex_);
+					cnt.slowest_widget = type_name;
+					break;
+				}
+			}
+		}
+
+		latency_histogram event_profiler::histogram(event_code evt_code, event_phase phase) const
+		{
+			latency_histogram hist;
+			if (evt_code >= event_code::end || phase >= event_phase::end)
+				return hist;
+
+			auto & cnt = const_cast<event_profiler*>(this)->_m_counters(evt_code, phase);
+
+			hist.samples = cnt.samples.load(std::memory_order_relaxed);
+			hist.total = std::chrono::microseconds{ cnt.total.load(std::memory_order_relaxed) };
+			hist.max = std::chrono::microseconds{ cnt.max.load(std::memory_order_relaxed) };
+
+			for (std::size_t i = 0; i < latency_histogram::bucket_count; ++i)
+				hist.buckets[i] = cnt.buckets[i].load(std::memory_order_relaxed);
+
+			std::lock_guard<std::mutex> lock(slowest_mutex_);
+			hist.slowest_widget = cnt.slowest_widget;
+			return hist;
+		}
+
+		void event_profiler::reset()
+		{
+			std::lock_guard<std::mutex> lock(slowest_mutex_);
+			for (auto & per_code : counters_)
+			{
+				for (auto & cnt : per_code)
+				{
+					cnt.samples.store(0, std::memory_order_relaxed);
+					cnt.total.store(0, std::memory_order_relaxed);
+					cnt.max.store(0, std::memory_order_relaxed);
+					for (auto & n : cnt.buckets)
+						n.store(0, std::memory_order_relaxed);
+
+					cnt.slowest_widget = nullptr;
+				}
+			}
+		}
+
+		event_profiler::counters& event_profiler::_m_counters(event_code evt_code, event_phase phase)
+		{
+			return counters_[static_cast<std::size_t>(evt_code)][static_cast<std::size_t>(phase)];
+		}
+		//end class event_profiler
+
+		//class latency_probe
+		latency_probe::latency_probe(event_code evt_code, event_phase phase, basic_window* wd)
+			:	evt_code_(evt_code),
+				phase_(phase),
+				window_(wd),
+				started_(event_profiler::clock_type::now()),
+				outer_(current_probe)
+		{
+			current_probe = this;
+		}
+
+		latency_probe::~latency_probe()
+		{
+			auto const elapsed = event_profiler::clock_type::now() - started_;
+
+			current_probe = outer_;
+			if (outer_)
+				outer_->nested_ += elapsed;
+
+			event_profiler::instance().record(evt_code_, phase_, window_, elapsed - nested_);
+		}
+		//end class latency_probe
+	}//end namespace detail
+}//end namespace nana
+
+#endif	//NANA_ENABLE_EVENT_PROFILING
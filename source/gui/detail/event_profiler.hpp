@@ -0,0 +1,102 @@
+/*
+ *	Event Profiler Implementation
+ *	Nana C++ Library(http://www.nanapro.org)
+ *	Copyright(C) 2003-2019 Jinhao(cnjinhao@hotmail.com)
+ *
+ *	Distributed under the Boost Software License, Version 1.0.
+ *	(See accompanying file LICENSE_1_0.txt or copy at
+ *	http://www.boost.org/LICENSE_1_0.txt)
+ *
+ *	@file: nana/gui/detail/event_profiler.hpp
+ *
+ *	!DON'T INCLUDE THIS HEADER FILE IN YOUR SOURCE CODE
+ */
+
+#ifndef NANA_GUI_DETAIL_EVENT_PROFILER_HPP
+#define NANA_GUI_DETAIL_EVENT_PROFILER_HPP
+
+#include <nana/push_ignore_diagnostic>
+#include <nana/config.hpp>
+#include <nana/gui/basis.hpp>
+#include <nana/gui/detail/event_code.hpp>
+
+#ifdef NANA_ENABLE_EVENT_PROFILING
+#	include <atomic>
+#	include <chrono>
+#	include <mutex>
+#endif
+
+namespace nana{
+	namespace detail
+	{
+#ifdef NANA_ENABLE_EVENT_PROFILING
+		/// Accumulates the latencies of the event phases in histograms, one histogram per event code and phase.
+		class event_profiler
+		{
+			event_profiler() = default;
+			event_profiler(const event_profiler&) = delete;
+			event_profiler& operator=(const event_profiler&) = delete;
+		public:
+			using clock_type = std::chrono::steady_clock;
+
+			static event_profiler& instance();
+
+			void record(event_code, event_phase, basic_window*, clock_type::duration);
+
+			latency_histogram histogram(event_code, event_phase) const;
+			void reset();
+		private:
+			struct counters
+			{
+				std::atomic<std::size_t> samples{ 0 };
+				std::atomic<long long> total{ 0 };
+				std::atomic<long long> max{ 0 };
+				std::atomic<std::size_t> buckets[latency_histogram::bucket_count];
+
+				const char* slowest_widget{ nullptr };
+
+				counters();
+			};
+
+			counters& _m_counters(event_code, event_phase);
+		private:
+			counters counters_[static_cast<std::size_t>(event_code::end)][static_cast<std::size_t>(event_phase::end)];
+			mutable std::mutex slowest_mutex_;
+		};
+
+		/// Measures the time which is spent in a scope and records it to the event profiler.
+		/**
+		 * The time of the nested probes is excluded, so that an event which is emitted by a
+		 * handler of another event is only accounted to the inner one.
+		 */
+		class latency_probe
+		{
+			latency_probe(const latency_probe&) = delete;
+			latency_probe& operator=(const latency_probe&) = delete;
+		public:
+			latency_probe(event_code, event_phase, basic_window*);
+			~latency_probe();
+		private:
+			event_code const evt_code_;
+			event_phase const phase_;
+			basic_window* const window_;
+			event_profiler::clock_type::time_point const started_;
+			event_profiler::clock_type::duration nested_{};
+			latency_probe* const outer_;
+		};
+#else
+		//The event profiling is disabled, the probe does nothing.
+		class latency_probe
+		{
+		public:
+			latency_probe(event_code, event_phase, basic_window*) noexcept
+			{
+			}
+		};
+#endif
+	}
+}//end namespace nana
+
+#include <nana/pop_ignore_diagnostic>
+
+#endif
@@ -1,33 +1,135 @@
 #include <nana/gui/detail/events_operation.hpp>
 #include <nana/gui/detail/bedrock.hpp>
+#include <memory>
 
 namespace nana
 {
 	namespace detail
 	{
+		namespace
+		{
+			/// A slab allocator for the dockers.
+			/**
+			 * The blocks are carved from chunks and grouped into size classes. A freed block is pushed to the
+			 * free list of its class and reused by the next docker of the same class. The dockers which are
+			 * larger than the largest class are allocated by the global operator new.
+			 */
+			class docker_pool
+			{
+				static constexpr std::size_t granularity = 32;
+				static constexpr std::size_t class_count = 4;		//32, 64, 96 and 128 bytes
+				static constexpr std::size_t blocks_per_chunk = 128;
+
+				struct block
+				{
+					block* next;
+				};
+			public:
+				static docker_pool& instance()
+				{
+					//The pool is never destroyed, because a docker of a static widget may be released after
+					//the destruction of the static objects of this module.
+					static docker_pool* pool = new docker_pool;
+					return *pool;
+				}
+
+				void* allocate(std::size_t size)
+				{
+					auto const cls = _m_class(size);
+					if (cls >= class_count)
+						return ::operator new(size);
+
+					std::lock_guard<std::mutex> lock(mutex_);
+
+					auto & head = free_[cls];
+					if (nullptr == head)
+						_m_grow(cls);
+
+					auto blk = head;
+					head = blk->next;
+					return blk;
+				}
+
+				void deallocate(void* p, std::size_t size) noexcept
+				{
+					auto const cls = _m_class(size);
+					if (cls >= class_count)
+						return ::operator delete(p);
+
+					std::lock_guard<std::mutex> lock(mutex_);
+
+					auto blk = static_cast<block*>(p);
+					blk->next = free_[cls];
+					free_[cls] = blk;
+				}
+			private:
+				static std::size_t _m_class(std::size_t size)
+				{
+					return (size ? (size - 1) / granularity : 0);
+				}
+
+				void _m_grow(std::size_t cls)
+				{
+					auto const block_size = (cls + 1) * granularity;
+
+					std::unique_ptr<char[]> chunk{ new char[block_size * blocks_per_chunk] };
+
+					auto p = chunk.get();
+					for (std::size_t i = 0; i < blocks_per_chunk; ++i, p += block_size)
+					{
+						auto blk = reinterpret_cast<block*>(p);
+						blk->next = free_[cls];
+						free_[cls] = blk;
+					}
+
+					chunks_.emplace_back(std::move(chunk));
+				}
+			private:
+				std::mutex mutex_;
+				block* free_[class_count]{};
+				std::vector<std::unique_ptr<char[]>> chunks_;
+			};
+		}
+
 		//class events_operation
-			using lock_guard = std::lock_guard<std::recursive_mutex>;
+			using lock_guard = std::lock_guard<std::mutex>;
 
 			void events_operation::register_evt(event_handle evt)
 			{
-				lock_guard lock(mutex_);
-				handles_.insert(evt);
+				auto & shd = _m_shard(evt);
+				lock_guard lock(shd.mutex);
+				shd.handles.insert(evt);
 			}
 
 			void events_operation::cancel(event_handle evt)
 			{
-				lock_guard lock(mutex_);
-				handles_.erase(evt);
+				auto & shd = _m_shard(evt);
+				lock_guard lock(shd.mutex);
+				shd.handles.erase(evt);
 			}
 
 			void events_operation::erase(event_handle evt)
 			{
-				lock_guard lock(mutex_);
+				//A docker is only deleted while the internal lock is held, so the handle is
+				//safe to be dereferenced after the lock of the shard is released.
+				internal_scope_guard lock;
+
+				bool exists;
+				{
+					auto & shd = _m_shard(evt);
+					lock_guard shard_lock(shd.mutex);
+					exists = (shd.handles.count(evt) != 0);
+				}
 
-				auto i = handles_.find(evt);
-				if (i != handles_.end())
+				if (exists)
 					reinterpret_cast<detail::event_docker_interface*>(evt)->get_event()->remove(evt);
 			}
+
+			events_operation::shard& events_operation::_m_shard(event_handle evt)
+			{
+				//The low bits of the address are always zero because of the alignment of dockers.
+				return shards_[(reinterpret_cast<std::size_t>(evt) >> 5) % shard_count];
+			}
 		//end namespace events_operation
 
 
@@ -42,6 +144,16 @@ namespace nana
 			{
 				return event_ptr;
 			}
+
+			void* docker_base::operator new(std::size_t size)
+			{
+				return docker_pool::instance().allocate(size);
+			}
+
+			void docker_base::operator delete(void* p, std::size_t size) noexcept
+			{
+				docker_pool::instance().deallocate(p, size);
+			}
 		//end class docker_base
 
 		//class event_base
@@ -0,0 +1,172 @@
+/*
+ *	Frame Scheduler Implementation
+ *	Nana C++ Library(http://www.nanapro.org)
+ *	Copyright(C) 2003-2019 Jinhao(cnjinhao@hotmail.com)
+ *
+ *	Distributed under the Boost Software License, Version 1.0.
+ *	(See accompanying file LICENSE_1_0.txt or copy at
+ *	http://www.boost.org/LICENSE_1_0.txt)
+ *
+ *	@file: nana/gui/detail/frame_scheduler.cpp
+ */
+
+#include "frame_scheduler.hpp"
+#include <nana/gui/detail/bedrock.hpp>
+#include <nana/gui/detail/window_manager.hpp>
+#include <nana/system/platform.hpp>
+#include "basic_window.hpp"
+#include <algorithm>
+
+namespace nana
+{
+	namespace detail
+	{
+		//class frame_scheduler
+		frame_scheduler::frame_scheduler(basic_window* root_wd)
+			: root_wd_(root_wd)
+		{
+		}
+
+		frame_scheduler::~frame_scheduler()
+		{
+			if (timer_)
+				timer_->stop();
+		}
+
+		void frame_scheduler::rate(unsigned hz)
+		{
+			if (hz == rate_)
+				return;
+
+			rate_ = hz;
+			stats_.rate = hz;
+
+			if (0 == hz)
+			{
+				interval_ = {};
+				if (timer_)
+					timer_->stop();
+				return;
+			}
+
+			interval_ = std::chrono::duration_cast<clock_type::duration>(std::chrono::seconds{ 1 }) / hz;
+
+			if (!timer_)
+			{
+				timer_.reset(new ::nana::timer);
+
+				auto root_wd = root_wd_;
+				timer_->elapse([root_wd]{
+					bedrock::instance().wd_manager().commit_frame(root_wd);
+				});
+			}
+
+			//The precision of the timer is milliseconds, a frame shorter than 1ms is flushed by the next request.
+			auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(interval_);
+			timer_->interval(ms.count() ? ms : std::chrono::milliseconds{ 1 });
+
+			//The timer only runs while a frame is pending, it's started by the first request of a frame.
+			if (!dirty_.empty())
+				_m_start_timer();
+		}
+
+		unsigned frame_scheduler::rate() const
+		{
+			return rate_;
+		}
+
+		bool frame_scheduler::enabled() const
+		{
+			return (0 != rate_);
+		}
+
+		bool frame_scheduler::request(basic_window* wd, const rectangle& area, bool redraw)
+		{
+			++stats_.requests;
+
+			auto i = std::find_if(dirty_.begin(), dirty_.end(), [wd](const dirty_window& dw){
+				return (dw.window == wd);
+			});
+
+			damage_.add(area);
+
+			if (i != dirty_.end())
+			{
+				//The request is merged into the pending frame of the window
+				++stats_.coalesced;
+				if (redraw)
+					i->redraw = true;
+			}
+			else
+			{
+				dirty_.push_back(dirty_window{ wd, redraw });
+
+				//The timer is bound to the thread which started it, a request from another thread is flushed immediately.
+				if ((1 == dirty_.size()) && !_m_start_timer())
+					return true;
+			}
+
+			return (clock_type::now() - last_frame_ >= interval_);
+		}
+
+		bool frame_scheduler::pending() const
+		{
+			return !dirty_.empty();
+		}
+
+		std::vector<rectangle> frame_scheduler::take(std::vector<dirty_window>& windows)
+		{
+			windows.swap(dirty_);
+			dirty_.clear();
+
+			//Nothing is pending until the next request
+			if (timer_)
+				timer_->stop();
+
+			auto damage = damage_.rectangles();
+			damage_.clear();
+
+			last_frame_ = clock_type::now();
+			return damage;
+		}
+
+		void frame_scheduler::finish(clock_type::time_point started)
+		{
+			++stats_.frames;
+
+			stats_.last_flush = std::chrono::duration_cast<std::chrono::microseconds>(clock_type::now() - started);
+			if (stats_.last_flush > stats_.max_flush)
+				stats_.max_flush = stats_.last_flush;
+		}
+
+		void frame_scheduler::erase(basic_window* wd)
+		{
+			for (auto i = dirty_.begin(); i != dirty_.end(); ++i)
+			{
+				if (i->window == wd)
+				{
+					dirty_.erase(i);
+					break;
+				}
+			}
+
+			if (dirty_.empty() && timer_)
+				timer_->stop();
+		}
+
+		const frame_statistics& frame_scheduler::statistics() const
+		{
+			return stats_;
+		}
+
+		bool frame_scheduler::_m_start_timer()
+		{
+			if (!timer_ || (root_wd_->thread_id != ::nana::system::this_thread_id()))
+				return false;
+
+			timer_->start();
+			return true;
+		}
+		//end class frame_scheduler
+	}//end namespace detail
+}//end namespace nana
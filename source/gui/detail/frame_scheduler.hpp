@@ -0,0 +1,96 @@
+/*
+ *	Frame Scheduler Implementation
+ *	Nana C++ Library(http://www.nanapro.org)
+ *	Copyright(C) 2003-2019 Jinhao(cnjinhao@hotmail.com)
+ *
+ *	Distributed under the Boost Software License, Version 1.0.
+ *	(See accompanying file LICENSE_1_0.txt or copy at
+ *	http://www.boost.org/LICENSE_1_0.txt)
+ *
+ *	@file: nana/gui/detail/frame_scheduler.hpp
+ *
+ *	!DON'T INCLUDE THIS HEADER FILE IN YOUR SOURCE CODE
+ */
+
+#ifndef NANA_GUI_DETAIL_FRAME_SCHEDULER_HPP
+#define NANA_GUI_DETAIL_FRAME_SCHEDULER_HPP
+
+#include <nana/push_ignore_diagnostic>
+#include <nana/gui/basis.hpp>
+#include <nana/gui/timer.hpp>
+#include "damage_region.hpp"
+#include <chrono>
+#include <memory>
+#include <vector>
+
+namespace nana{
+	namespace detail
+	{
+		struct basic_window;
+
+		/// Collects the dirty windows and the damaged area of a root window, and flushes them
+		/// to the screen at most once per frame. The timer runs only while a frame is pending.
+		class frame_scheduler
+		{
+			frame_scheduler(const frame_scheduler&) = delete;
+			frame_scheduler& operator=(const frame_scheduler&) = delete;
+		public:
+			using clock_type = std::chrono::steady_clock;
+
+			struct dirty_window
+			{
+				basic_window* window;
+				bool redraw;	///< Indicates whether the window is refreshed before the frame is flushed.
+			};
+
+			frame_scheduler(basic_window* root_wd);
+			~frame_scheduler();
+
+			/// Sets the frame rate in Hz. Zero disables the frame pacing.
+			void rate(unsigned hz);
+			unsigned rate() const;
+
+			bool enabled() const;
+
+			/// Records a request of flushing an area of the root graphics.
+			/**
+			 * @param wd The window which requests the flush.
+			 * @param area The area to be flushed, in the coordinate of the root window.
+			 * @param redraw Indicates whether the window is to be refreshed before flushing.
+			 * @return true if the frame is due and should be committed immediately.
+			 */
+			bool request(basic_window* wd, const rectangle& area, bool redraw);
+
+			bool pending() const;
+
+			/// Takes the pending windows and the damaged rectangles, and starts a new frame.
+			std::vector<rectangle> take(std::vector<dirty_window>& windows);
+
+			/// Accounts the time which is spent on flushing a frame.
+			void finish(clock_type::time_point started);
+
+			/// Removes a window which is being destroyed from the pending list.
+			void erase(basic_window* wd);
+
+			const frame_statistics& statistics() const;
+		private:
+			/// Starts the timer to commit the pending frame, returns false if it can't be started in the current thread.
+			bool _m_start_timer();
+		private:
+			basic_window* const root_wd_;
+			unsigned rate_{ 0 };
+			clock_type::duration interval_{};
+			clock_type::time_point last_frame_{};
+
+			std::vector<dirty_window> dirty_;
+			damage_region damage_;
+
+			frame_statistics stats_;
+			std::unique_ptr<::nana::timer> timer_;
+		};
+	}
+}//end namespace nana
+
+#include <nana/pop_ignore_diagnostic>
+
+#endif
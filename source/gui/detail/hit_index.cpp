@@ -0,0 +1,244 @@
+/*
+ *	Hit Index Implementation
+ *	Nana C++ Library(http://www.nanapro.org)
+ *	Copyright(C) 2003-2019 Jinhao(cnjinhao@hotmail.com)
+ *
+ *	Distributed under the Boost Software License, Version 1.0.
+ *	(See accompanying file LICENSE_1_0.txt or copy at
+ *	http://www.boost.org/LICENSE_1_0.txt)
+ *
+ *	@file: nana/gui/detail/hit_index.cpp
+ */
+
+#include "hit_index.hpp"
+#include "basic_window.hpp"
+#include <algorithm>
+
+namespace nana
+{
+	namespace detail
+	{
+		namespace
+		{
+			//The width and height of a cell are 64 pixels
+			constexpr int cell_bits = 6;
+
+			//A widget which covers more cells than this is kept in the list of large widgets
+			constexpr std::size_t large_cells = 64;
+
+			int cell_of(int n)
+			{
+				//Rounds toward negative infinity, the widgets may be placed at negative positions.
+				return (n >= 0 ? (n >> cell_bits) : -((-n + (1 << cell_bits) - 1) >> cell_bits));
+			}
+
+			std::uint64_t cell_key(int x, int y)
+			{
+				return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) | static_cast<std::uint32_t>(y);
+			}
+
+			struct cell_range
+			{
+				int left, top, right, bottom;	//inclusive
+
+				cell_range(const rectangle& r)
+					:	left(cell_of(r.x)), top(cell_of(r.y)),
+						right(cell_of(r.right() - 1)), bottom(cell_of(r.bottom() - 1))
+				{}
+
+				std::size_t count() const
+				{
+					return static_cast<std::size_t>(right - left + 1) * static_cast<std::size_t>(bottom - top + 1);
+				}
+			};
+
+			template<typename Entries>
+			void insert_ranked(Entries& entries, std::size_t rank, basic_window* wd)
+			{
+				auto i = std::lower_bound(entries.begin(), entries.end(), rank, [](const typename Entries::value_type& e, std::size_t rank){
+					return (e.rank < rank);
+				});
+				entries.insert(i, typename Entries::value_type{ rank, wd });
+			}
+
+			template<typename Entries>
+			void erase_ranked(Entries& entries, std::size_t rank)
+			{
+				auto i = std::lower_bound(entries.begin(), entries.end(), rank, [](const typename Entries::value_type& e, std::size_t rank){
+					return (e.rank < rank);
+				});
+
+				if ((i != entries.end()) && (i->rank == rank))
+					entries.erase(i);
+			}
+		}
+
+		//class hit_index
+		hit_index::hit_index(basic_window* root_wd)
+			: root_wd_(root_wd)
+		{
+		}
+
+		void hit_index::invalidate()
+		{
+			dirty_ = true;
+		}
+
+		void hit_index::update(basic_window* wd, bool with_children)
+		{
+			//The index will be rebuilt
+			if (dirty_)
+				return;
+
+			_m_update(wd, with_children);
+		}
+
+		basic_window* hit_index::find(const point& pos)
+		{
+			if (dirty_)
+				_m_rebuild();
+
+			static const std::vector<entry> empty_cell;
+
+			auto i = cells_.find(cell_key(cell_of(pos.x), cell_of(pos.y)));
+			auto & cell = (i != cells_.end() ? i->second : empty_cell);
+
+			//Merges the cell and the large widgets from top to bottom, the first one
+			//which is hit is the topmost.
+			auto c = cell.crbegin();
+			auto l = large_.crbegin();
+			while ((c != cell.crend()) || (l != large_.crend()))
+			{
+				basic_window* wd;
+				if ((l == large_.crend()) || ((c != cell.crend()) && (c->rank > l->rank)))
+					wd = (c++)->window;
+				else
+					wd = (l++)->window;
+
+				if (_m_hit(wd, pos))
+					return wd;
+			}
+
+			return root_wd_;
+		}
+
+		void hit_index::_m_rebuild()
+		{
+			records_.clear();
+			cells_.clear();
+			large_.clear();
+			next_rank_ = 0;
+
+			for (auto child : root_wd_->children)
+				_m_build(child);
+
+			dirty_ = false;
+		}
+
+		void hit_index::_m_build(basic_window* wd)
+		{
+			//A nested form is a root window, it has its own index.
+			if (category::flags::root == wd->other.category)
+				return;
+
+			//Ranks the widgets by the order of painting, a widget is painted before its children.
+			auto & rec = records_[wd];
+			rec.rank = next_rank_++;
+			rec.area = rectangle{ wd->pos_root, wd->dimension };
+			_m_insert(wd, rec);
+
+			for (auto child : wd->children)
+				_m_build(child);
+		}
+
+		void hit_index::_m_update(basic_window* wd, bool with_children)
+		{
+			if (category::flags::root == wd->other.category)
+				return;
+
+			auto i = records_.find(wd);
+			if (i == records_.end())
+			{
+				//The widget is not indexed yet
+				dirty_ = true;
+				return;
+			}
+
+			auto & rec = i->second;
+			rectangle area{ wd->pos_root, wd->dimension };
+			if (area != rec.area)
+			{
+				_m_erase(rec);
+				rec.area = area;
+				_m_insert(wd, rec);
+			}
+
+			if (with_children)
+			{
+				for (auto child : wd->children)
+				{
+					_m_update(child, true);
+					if (dirty_)
+						return;
+				}
+			}
+		}
+
+		void hit_index::_m_insert(basic_window* wd, const record& rec)
+		{
+			if (rec.area.empty())
+				return;
+
+			cell_range range{ rec.area };
+			if (range.count() > large_cells)
+			{
+				insert_ranked(large_, rec.rank, wd);
+				return;
+			}
+
+			for (int y = range.top; y <= range.bottom; ++y)
+				for (int x = range.left; x <= range.right; ++x)
+					insert_ranked(cells_[cell_key(x, y)], rec.rank, wd);
+		}
+
+		void hit_index::_m_erase(const record& rec)
+		{
+			if (rec.area.empty())
+				return;
+
+			cell_range range{ rec.area };
+			if (range.count() > large_cells)
+			{
+				erase_ranked(large_, rec.rank);
+				return;
+			}
+
+			for (int y = range.top; y <= range.bottom; ++y)
+			{
+				for (int x = range.left; x <= range.right; ++x)
+				{
+					auto i = cells_.find(cell_key(x, y));
+					if (i == cells_.end())
+						continue;
+
+					erase_ranked(i->second, rec.rank);
+					if (i->second.empty())
+						cells_.erase(i);
+				}
+			}
+		}
+
+		//Tests the widget and its ancestors like the window_manager descends from the root window,
+		//a widget is reachable only if all its ancestors are visible and contain the point.
+		bool hit_index::_m_hit(basic_window* wd, const point& pos) const
+		{
+			for (; wd && (wd != root_wd_); wd = wd->parent)
+			{
+				if ((!wd->visible) || !rectangle{ wd->pos_root, wd->dimension }.is_hit(pos))
+					return false;
+			}
+			return (wd == root_wd_);
+		}
+		//end class hit_index
+	}//end namespace detail
+}//end namespace nana
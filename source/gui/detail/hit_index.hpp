@@ -0,0 +1,90 @@
+/*
+ *	Hit Index Implementation
+ *	Nana C++ Library(http://www.nanapro.org)
+ *	Copyright(C) 2003-2019 Jinhao(cnjinhao@hotmail.com)
+ *
+ *	Distributed under the Boost Software License, Version 1.0.
+ *	(See accompanying file LICENSE_1_0.txt or copy at
+ *	http://www.boost.org/LICENSE_1_0.txt)
+ *
+ *	@file: nana/gui/detail/hit_index.hpp
+ *
+ *	!DON'T INCLUDE THIS HEADER FILE IN YOUR SOURCE CODE
+ */
+
+#ifndef NANA_GUI_DETAIL_HIT_INDEX_HPP
+#define NANA_GUI_DETAIL_HIT_INDEX_HPP
+
+#include <nana/push_ignore_diagnostic>
+#include <nana/basic_types.hpp>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace nana{
+	namespace detail
+	{
+		struct basic_window;
+
+		/// A uniform grid of the rectangles of the widgets in a root window, for finding the window under a point.
+		/**
+		 * Every widget is ranked by the order of painting, a widget which is painted later is on top of the former.
+		 * A cell of the grid keeps the widgets which overlap the cell ordered by the rank. The visibility is not
+		 * indexed, it is tested when a point is looked up, so showing and hiding a widget costs nothing.
+		 * Moving and resizing update the cells of the widget, creating, destroying and reparenting change the ranks,
+		 * they invalidate the index and it is rebuilt by the next lookup.
+		 */
+		class hit_index
+		{
+		public:
+			hit_index(basic_window* root_wd);
+
+			/// Discards the index, it's rebuilt by the next lookup.
+			void invalidate();
+
+			/// Updates the cells of a widget after it is moved or resized.
+			/**
+			 * @param wd The widget which is moved or resized.
+			 * @param with_children Indicates whether the children are updated, the children are moved with their parent.
+			 */
+			void update(basic_window* wd, bool with_children);
+
+			/// Returns the topmost visible window which contains the point, it returns the root window if no widget contains it.
+			/**
+			 * @param pos A point in the coordinate of the root window, it must be in the rectangle of the root window.
+			 */
+			basic_window* find(const point& pos);
+		private:
+			struct entry
+			{
+				std::size_t rank;
+				basic_window* window;
+			};
+
+			struct record
+			{
+				std::size_t rank;
+				rectangle area;		///< The area which the widget is indexed with.
+			};
+
+			void _m_rebuild();
+			void _m_build(basic_window*);
+			void _m_update(basic_window*, bool with_children);
+			void _m_insert(basic_window*, const record&);
+			void _m_erase(const record&);
+			bool _m_hit(basic_window*, const point&) const;
+		private:
+			basic_window* root_wd_;
+			bool dirty_{ true };
+			std::size_t next_rank_{ 0 };
+
+			std::unordered_map<basic_window*, record> records_;
+			std::unordered_map<std::uint64_t, std::vector<entry>> cells_;
+			std::vector<entry> large_;	///< The widgets which cover too many cells, such as panels, are not put into the cells.
+		};
+	}
+}//end namespace nana
+
+#include <nana/pop_ignore_diagnostic>
+
+#endif
@@ -16,6 +16,8 @@
 
 #include <nana/push_ignore_diagnostic>
 #include "basic_window.hpp"
+#include "frame_scheduler.hpp"
+#include "hit_index.hpp"
 #include <nana/gui/detail/inner_fwd.hpp>
 #include <nana/paint/graphics.hpp>
 
@@ -63,6 +65,8 @@ namespace nana{
 
 			nana::paint::graphics	root_graph;
 			shortkey_container		shortkeys;
+			std::unique_ptr<frame_scheduler> frame;	///< Created when the frame pacing is enabled for the root window.
+			hit_index				hits;	///< Finds the widget under the mouse cursor.
 
 			struct condition_rep
 			{
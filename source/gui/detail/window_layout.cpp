@@ -21,12 +21,74 @@ namespace nana
 {
 	namespace detail
 	{
+		namespace
+		{
+			//The opaque children of a window, which cover the children that are pasted before them.
+			class occlusion
+			{
+			public:
+				occlusion(const std::vector<basic_window*>& children, const rectangle& parent_rect)
+				{
+					//There is nothing to be covered by a single child
+					if (children.size() < 2)
+						return;
+
+					rectangle r;
+					for (std::size_t pos = 1; pos < children.size(); ++pos)
+					{
+						auto child = children[pos];
+						if (_m_opaque(child) && overlap(rectangle{ child->pos_root, child->dimension }, parent_rect, r))
+							occluders_.push_back(occluder{ pos, r });
+					}
+				}
+
+				/// Determines whether the visible area of a child is wholly covered by an opaque child which is pasted after it.
+				bool covered(std::size_t pos, const rectangle& child_r, const rectangle& parent_rect) const
+				{
+					rectangle visible;
+					if (occluders_.empty() || !overlap(child_r, parent_rect, visible))
+						return false;
+
+					for (auto i = occluders_.crbegin(); (i != occluders_.crend()) && (i->pos > pos); ++i)
+					{
+						if (::nana::covered(visible, i->area))
+							return true;
+					}
+					return false;
+				}
+			private:
+				static bool _m_opaque(const basic_window* wd)
+				{
+					//A lite widget has no graphics, a glass window shows its background, and a nested root window
+					//is not pasted to the graphics of its parent.
+					return (wd->visible && (category::flags::widget == wd->other.category) && (nullptr == wd->effect.bground) &&
+						!wd->flags.translucent && ((!wd->drawer.graphics.empty()) || wd->flags.transient_backing));
+				}
+			private:
+				struct occluder
+				{
+					std::size_t pos;
+					rectangle area;
+				};
+
+				std::vector<occluder> occluders_;
+			};
+		}
+
 		//class window_layout
-			void window_layout::paint(basic_window* wd, paint_operation operation, bool req_refresh_children)
+			void window_layout::paint(basic_window* wd, paint_operation operation, bool req_refresh_children, const rectangle* damage)
 			{
 				if (wd->flags.refreshing && (paint_operation::try_refresh == operation))
 					return;
 
+				//The window missed a refresh while it was occluded by its siblings.
+				if (wd->flags.refresh_deferred && !wd->flags.refreshing)
+				{
+					wd->flags.refresh_deferred = false;
+					operation = paint_operation::try_refresh;
+					req_refresh_children = true;
+				}
+
 				if (nullptr == wd->effect.bground)
 				{
 					if ((paint_operation::try_refresh == operation) && (!wd->drawer.graphics.empty()))
@@ -35,13 +97,13 @@ namespace nana
 						wd->drawer.refresh();
 						wd->flags.refreshing = false;
 					}
-					maproot(wd, (paint_operation::none != operation), req_refresh_children);
+					maproot(wd, (paint_operation::none != operation), req_refresh_children, (req_refresh_children ? nullptr : damage));
 				}
 				else
 					_m_paint_glass_window(wd, (paint_operation::try_refresh == operation), req_refresh_children, false, true);
 			}
 
-			bool window_layout::maproot(basic_window* wd, bool have_refreshed, bool req_refresh_children)
+			bool window_layout::maproot(basic_window* wd, bool have_refreshed, bool req_refresh_children, const rectangle* damage)
 			{
 				auto check_opaque = wd->seek_non_lite_widget_ancestor();
 				if (check_opaque && check_opaque->flags.refreshing)
@@ -50,6 +112,12 @@ namespace nana
 				nana::rectangle vr;
 				if (read_visual_rectangle(wd, vr))
 				{
+					//Only the damaged part is copied, the children and the overlaps are clipped by it as well.
+					if (damage && !overlap(*damage, rectangle{ vr }, vr))
+						return true;
+
+					wd->drawer.acquire_transient();
+
 					//get the root graphics
 					auto& graph = *(wd->root_graph);
 
@@ -66,6 +134,8 @@ namespace nana
 							nana::point p_src;
 							for (auto & el : blocks)
 							{
+								el.window->drawer.acquire_transient();
+
 								p_src.x = el.r.x - el.window->pos_root.x;
 								p_src.y = el.r.y - el.window->pos_root.y;
 								graph.bitblt(el.r, (el.window->drawer.graphics), p_src);
@@ -74,7 +144,7 @@ namespace nana
 							}
 						}
 					}
-					_m_notify_glasses(wd);
+					_m_notify_glasses(wd, vr);
 					return true;
 				}
 				return false;
@@ -235,6 +305,7 @@ namespace nana
 						beg = beg->parent;
 					}
 
+					beg->drawer.acquire_transient();
 					glass_buffer.bitblt(::nana::rectangle{ wd->dimension }, beg->drawer.graphics, wd->pos_root - beg->pos_root);
 					
 					nana::rectangle r(wd->pos_owner, wd->dimension);
@@ -255,6 +326,7 @@ namespace nana
 							nana::rectangle ovlp;
 							if (child->visible && overlap(r, rectangle(child->pos_owner, child->dimension), ovlp))
 							{
+								child->drawer.acquire_transient();
 								if (category::flags::lite_widget != child->other.category)
 									glass_buffer.bitblt(nana::rectangle(ovlp.x - pre->pos_owner.x, ovlp.y - pre->pos_owner.y, ovlp.width, ovlp.height), child->drawer.graphics, nana::point(ovlp.x - child->pos_owner.x, ovlp.y - child->pos_owner.y));
 								ovlp.x += pre->pos_root.x;
@@ -265,7 +337,10 @@ namespace nana
 					}
 				}
 				else
+				{
+					wd->parent->drawer.acquire_transient();
 					glass_buffer.bitblt(::nana::rectangle{ wd->dimension }, wd->parent->drawer.graphics, wd->pos_owner);
+				}
 
 				const rectangle r_of_wd{ wd->pos_owner, wd->dimension };
 				for (auto child : wd->parent->children)
@@ -276,6 +351,7 @@ namespace nana
 					nana::rectangle ovlp;
 					if (child->visible && overlap(r_of_wd, rectangle{ child->pos_owner, child->dimension }, ovlp))
 					{
+						child->drawer.acquire_transient();
 						if (category::flags::lite_widget != child->other.category)
 							glass_buffer.bitblt(nana::rectangle{ ovlp.x - wd->pos_owner.x, ovlp.y - wd->pos_owner.y, ovlp.width, ovlp.height }, child->drawer.graphics, {ovlp.position() - child->pos_owner});
 
@@ -287,15 +363,21 @@ namespace nana
 
 				if (wd->effect.bground)
 					wd->effect.bground->take_effect(wd, glass_buffer);
+
+				wd->flags.bground_damaged = false;
 			}
 
 			void window_layout::_m_paste_children(basic_window* wd, bool have_refreshed, bool req_refresh_children, const nana::rectangle& parent_rect, nana::paint::graphics& graph, const nana::point& graph_rpos)
 			{
+				occlusion const occluders{ wd->children, parent_rect };
+
 				nana::rectangle rect;
-				for (auto child : wd->children)
+				for (std::size_t pos = 0; pos < wd->children.size(); ++pos)
 				{
+					auto const child = wd->children[pos];
+
 					//it will not past children if no drawer and visible is false.
-					if ((false == child->visible) || ((category::flags::lite_widget != child->other.category) && child->drawer.graphics.empty()))
+					if ((false == child->visible) || ((category::flags::lite_widget != child->other.category) && child->drawer.graphics.empty() && !child->flags.transient_backing))
 						continue;
 
 					if (category::flags::root == child->other.category)
@@ -304,13 +386,30 @@ namespace nana
 						continue;
 					}
 
+					if (occluders.covered(pos, nana::rectangle{ child->pos_root, child->dimension }, parent_rect))
+					{
+						//Nobody can see the child, the requested refresh is deferred to the next time it is painted.
+						if (req_refresh_children)
+							child->flags.refresh_deferred = true;
+
+						if (child->effect.bground)
+							child->flags.bground_damaged = true;
+						continue;
+					}
+
+					//The refresh which is deferred while the child is occluded.
+					auto const req_refresh_child = (req_refresh_children || child->flags.refresh_deferred);
+					child->flags.refresh_deferred = false;
+
 					if (nullptr == child->effect.bground)
 					{
 						if (overlap(nana::rectangle{ child->pos_root, child->dimension }, parent_rect, rect))
 						{
+							//A released transient graphics is made and rendered, it isn't refreshed again.
+							bool const acquired = child->drawer.acquire_transient();
 							if (category::flags::lite_widget != child->other.category)
 							{
-								if (req_refresh_children && (false == child->flags.refreshing))
+								if (req_refresh_child && (false == child->flags.refreshing) && !acquired)
 								{
 									child->flags.refreshing = true;
 									child->drawer.refresh();
@@ -320,15 +419,17 @@ namespace nana
 								graph.bitblt(nana::rectangle(rect.x - graph_rpos.x, rect.y - graph_rpos.y, rect.width, rect.height),
 									child->drawer.graphics, nana::point(rect.x - child->pos_root.x, rect.y - child->pos_root.y));
 							}
-							//req_refresh_children determines whether the child has been refreshed, and also determines whether
+							//req_refresh_child determines whether the child has been refreshed, and also determines whether
 							//the children of child to be refreshed.
-							_m_paste_children(child, req_refresh_children, req_refresh_children, rect, graph, graph_rpos);
+							_m_paste_children(child, req_refresh_child, req_refresh_child, rect, graph, graph_rpos);
 						}
 					}
-					else
+					else if (overlap(nana::rectangle{ child->pos_root, child->dimension }, parent_rect, rect))
 					{
-						//Update the glass window's background if the parent have_refreshed.
-						_m_paint_glass_window(child, have_refreshed, req_refresh_children, true, false);
+						//The pasted area of the parent is the background of the glass window, its content may be changed even if
+						//the parent is not refreshed, e.g, the parent is drawn directly and updated.
+						child->flags.bground_damaged = true;
+						_m_paint_glass_window(child, have_refreshed, req_refresh_child, true, false);
 					}
 				}
 			}
@@ -345,10 +446,10 @@ namespace nana
 				{
 					if (is_redraw || called_by_notify)
 					{
-						//The background is made by more than calling by notification(such as redraw of parent,
-						//redraw of siblings which are covered by wd), sometimes it should be remade when an attribute
-						//of the wd is changed(such as its background color is changed).
-						if (called_by_notify || wd->flags.make_bground_declared)
+						//The background is remade when the covered area of the parent or siblings is damaged, or when
+						//an attribute of the wd is changed(such as its background color is changed). Otherwise the
+						//effected background is kept, the effect such as blur is not taken again.
+						if (wd->flags.bground_damaged || wd->flags.make_bground_declared)
 						{
 							make_bground(wd);
 							wd->flags.make_bground_declared = false;
@@ -370,20 +471,20 @@ namespace nana
 						read_overlaps(wd, vr, blocks);
 						for (auto & n : blocks)
 						{
+							n.window->drawer.acquire_transient();
 							root_graph.bitblt(n.r, (n.window->drawer.graphics), nana::point(n.r.x - n.window->pos_root.x, n.r.y - n.window->pos_root.y));
 						}
 					}
 
 					if (notify_other)
-						_m_notify_glasses(wd);
+						_m_notify_glasses(wd, vr);
 				}
 			}
 
 			/// Notify the glass windows that are overlapped with the specified visual rectangle.
 			/// If a child window of sigwd is a glass window, it doesn't to be notified.
-			void window_layout::_m_notify_glasses(basic_window* const sigwd)
+			void window_layout::_m_notify_glasses(basic_window* const sigwd, const nana::rectangle& damage)
 			{
-				nana::rectangle r_of_sigwd(sigwd->pos_root, sigwd->dimension);
 				for (auto wd : data_sect.effects_bground_windows)
 				{
 					//Don't notify the window if both native root windows are not same(e.g. wd and sigwd have
@@ -394,7 +495,7 @@ namespace nana
 						continue;
 
 					if (wd == sigwd || !wd->displayed() ||
-						(false == overlapped(nana::rectangle{ wd->pos_root, wd->dimension }, r_of_sigwd)))
+						(false == overlapped(nana::rectangle{ wd->pos_root, wd->dimension }, damage)))
 						continue;
 
 					if (sigwd->parent == wd->parent)
@@ -431,6 +532,7 @@ namespace nana
 					else
 						continue;
 
+					wd->flags.bground_damaged = true;
 					_m_paint_glass_window(wd, true, false, true, true);
 				}
 			}
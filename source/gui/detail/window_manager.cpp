@@ -22,6 +22,7 @@
 #include "effects_renderer.hpp"
 #include "window_register.hpp"
 #include "inner_fwd_implement.hpp"
+#include "backing_store.hpp"
 
 #include <stdexcept>
 #include <algorithm>
@@ -33,6 +34,10 @@
 #include <mutex>
 #endif
 
+#ifdef NANA_ENABLE_FINE_GRAINED_LOCK
+#include <shared_mutex>
+#endif
+
 namespace nana
 {
 
@@ -148,6 +153,8 @@ namespace nana
 			wpassoc(other.wpassoc),
 			root_graph(std::move(other.root_graph)),
 			shortkeys(std::move(other.shortkeys)),
+			frame(std::move(other.frame)),
+			hits(std::move(other.hits)),
 			condition(std::move(other.condition))
 		{
 			other.wpassoc = nullptr;	//moved-from
@@ -155,7 +162,8 @@ namespace nana
 
 		root_misc::root_misc(basic_window * wd, unsigned width, unsigned height)
 			: window(wd),
-			root_graph({ width, height })
+			root_graph({ width, height }),
+			hits(wd)
 		{
 			condition.ignore_tab = false;
 			condition.pressed = nullptr;
@@ -283,9 +291,34 @@ namespace detail
 				paint::image default_icon_small;
 
 				lite_map<basic_window*, std::vector<std::function<void()>>> safe_place;
+
+				backing_store_collector backing_stores;
+
+#ifdef NANA_ENABLE_FINE_GRAINED_LOCK
+				//Guards the window registry and the geometry of windows for the read-only queries.
+				//A writer always locks it after the internal lock, and never holds it while emitting events.
+				mutable std::shared_mutex registry_mutex;
+#endif
 			};
 		//end struct wdm_private_impl
 
+			//class registry_write_guard
+			window_manager::registry_write_guard::registry_write_guard(const window_manager& wd_mngr)
+				: wd_mngr_(wd_mngr)
+			{
+#ifdef NANA_ENABLE_FINE_GRAINED_LOCK
+				wd_mngr_.impl_->registry_mutex.lock();
+#endif
+			}
+
+			window_manager::registry_write_guard::~registry_write_guard()
+			{
+#ifdef NANA_ENABLE_FINE_GRAINED_LOCK
+				wd_mngr_.impl_->registry_mutex.unlock();
+#endif
+			}
+			//end class registry_write_guard
+
 			//class revertible_mutex
 			struct thread_refcount
 			{
@@ -468,6 +501,34 @@ namespace detail
 			return mutex_;
 		}
 
+		void window_manager::lock_shared() const
+		{
+#ifdef NANA_ENABLE_FINE_GRAINED_LOCK
+			impl_->registry_mutex.lock_shared();
+#else
+			mutex_.lock();
+#endif
+		}
+
+		void window_manager::unlock_shared() const
+		{
+#ifdef NANA_ENABLE_FINE_GRAINED_LOCK
+			impl_->registry_mutex.unlock_shared();
+#else
+			mutex_.unlock();
+#endif
+		}
+
+		bool window_manager::registered(basic_window* wd) const
+		{
+#ifdef NANA_ENABLE_FINE_GRAINED_LOCK
+			//The cache of the register is not shareable between the readers.
+			return impl_->wd_register.contains(wd);
+#else
+			return impl_->wd_register.available(wd);
+#endif
+		}
+
 		void window_manager::all_handles(std::vector<basic_window*> &v) const
 		{
 			//Thread-Safe Required!
@@ -544,7 +605,10 @@ namespace detail
 				auto* value = impl_->misc_register.insert(result.native_handle, root_misc(wd, result.width, result.height));
 
 				wd->bind_native_window(result.native_handle, result.width, result.height, result.extra_width, result.extra_height, value->root_graph);
-				impl_->wd_register.insert(wd);
+				{
+					registry_write_guard rwg{ *this };
+					impl_->wd_register.insert(wd);
+				}
 
 				bedrock::inc_window(wd->thread_id);
 				this->icon(wd, impl_->default_icon_small, impl_->default_icon_big);
@@ -571,6 +635,9 @@ namespace detail
 			else
 				wd = new basic_window(parent, std::move(wdg_notifier), r, (category::widget_tag**)nullptr);
 
+			_m_invalidate_hits(wd);
+
+			registry_write_guard rwg{ *this };
 			impl_->wd_register.insert(wd);
 			return wd;
 		}
@@ -638,6 +705,13 @@ namespace detail
 				parent = parent->parent;
 			}
 
+			//The update area is in the root coordinates, like the damaged rectangles
+			if (parent)
+			{
+				update_area.x += parent->pos_root.x;
+				update_area.y += parent->pos_root.y;
+			}
+
 			update(parent, false, false, &update_area);
 		}
 
@@ -650,6 +724,8 @@ namespace detail
 			if (category::flags::root == wd->other.category)
 			{
 				impl_->misc_register.erase(wd->root);
+
+				registry_write_guard rwg{ *this };
 				impl_->wd_register.remove(wd);
 			}
 		}
@@ -688,6 +764,10 @@ namespace detail
 			{
 				auto nv = (category::flags::root == wd->other.category ? wd->root : nullptr);
 
+				//The released graphics are made before the expose, they are rendered by the expose.
+				if (!nv)
+					impl_->backing_stores.visible(wd, visible, impl_->wd_register.queue());
+
 				if(visible && wd->effect.bground)
 					window_layer::make_bground(wd);
 
@@ -714,7 +794,7 @@ namespace detail
 			{
 				auto rrt = root_runtime(root);
 				if (rrt && _m_effective(rrt->window, pos))
-					return _m_find(rrt->window, pos);
+					return rrt->hits.find(pos);
 
 				return nullptr;
 			}
@@ -725,7 +805,7 @@ namespace detail
 			auto rrt = root_runtime(root);
 			if (rrt && _m_effective(rrt->window, pos))
 			{
-				auto target = _m_find(rrt->window, pos);
+				auto target = rrt->hits.find(pos);
 
 				auto p = target;
 				while (p)
@@ -753,9 +833,13 @@ namespace detail
 					{
 						point delta{ x - wd->pos_owner.x, y - wd->pos_owner.y };
 
-						wd->pos_owner.x = x;
-						wd->pos_owner.y = y;
+						{
+							registry_write_guard rwg{ *this };
+							wd->pos_owner.x = x;
+							wd->pos_owner.y = y;
+						}
 						_m_move_core(wd, delta);
+						_m_update_hits(wd, true);
 
 						auto &brock = bedrock::instance();
 						arg_move arg;
@@ -805,8 +889,12 @@ namespace detail
 				if(r.x != wd->pos_owner.x || r.y != wd->pos_owner.y)
 				{
 					auto delta = r.position() - wd->pos_owner;
-					wd->pos_owner = r.position();
+					{
+						registry_write_guard rwg{ *this };
+						wd->pos_owner = r.position();
+					}
 					_m_move_core(wd, delta);
+					_m_update_hits(wd, true);
 					moved = true;
 
 					if ((!size_changed) && wd->effect.bground)
@@ -840,8 +928,11 @@ namespace detail
 
 				if(size_changed)
 				{
-					wd->dimension.width = root_r.width;
-					wd->dimension.height = root_r.height;
+					{
+						registry_write_guard rwg{ *this };
+						wd->dimension.width = root_r.width;
+						wd->dimension.height = root_r.height;
+					}
 					wd->drawer.graphics.make(wd->dimension);
 					wd->root_graph->make(wd->dimension);
 					native_interface::move_window(wd->root, root_r);
@@ -919,23 +1010,36 @@ namespace detail
 			//Before resizing the window, creates the new graphics
 			paint::graphics graph;
 			paint::graphics root_graph;
+			bool graph_state = wd->drawer.graphics.empty();
 			if (category::flags::lite_widget != wd->other.category)
 			{
 				//If allocation fails, here throws std::bad_alloc.
-				graph.make(sz);
-				graph.typeface(wd->drawer.graphics.typeface());
 				if (category::flags::root == wd->other.category)
+				{
+					graph.make(sz);
+					graph.typeface(wd->drawer.graphics.typeface());
 					root_graph.make(sz);
+				}
+				else if (!wd->flags.backing_released)
+				{
+					//The graphics of a widget is resized in place, its pixmap is reused if it is large enough.
+					//A released graphics is made with the new size when the widget is shown.
+					wd->drawer.graphics.resize(sz);
+				}
 			}
 
 			auto pre_sz = wd->dimension;
 
-			wd->dimension = sz;
+			{
+				registry_write_guard rwg{ *this };
+				wd->dimension = sz;
+			}
+			_m_update_hits(wd, false);
 
 			if(category::flags::lite_widget != wd->other.category)
 			{
-				bool graph_state = wd->drawer.graphics.empty();
-				wd->drawer.graphics.swap(graph);
+				if (category::flags::root == wd->other.category)
+					wd->drawer.graphics.swap(graph);
 
 				//It shall make a typeface_changed() call when the graphics state is changing.
 				//Because when a widget is created with zero-size, it may get some wrong results in typeface_changed() call
@@ -950,7 +1054,11 @@ namespace detail
 					if(false == passive)
 						if (!native_interface::window_size(wd->root, sz + nana::size(wd->extra_width, wd->extra_height)))
 						{
-							wd->dimension = pre_sz;
+							{
+								registry_write_guard rwg{ *this };
+								wd->dimension = pre_sz;
+							}
+							_m_update_hits(wd, false);
 							wd->drawer.graphics.swap(graph);
 							wd->root_graph->swap(root_graph);
 							wd->drawer.typeface_changed();
@@ -970,6 +1078,22 @@ namespace detail
 				refresh_tree(child);
 			}
 
+			auto root_attr = wd->root_widget->other.attribute.root;
+			if (root_attr->geometry_batch)
+			{
+				//The event is emitted once with the final size when the batch is committed.
+				auto i = std::find_if(root_attr->batch_resized.begin(), root_attr->batch_resized.end(), [wd](const std::pair<basic_window*, bool>& rs){
+					return (rs.first == wd);
+				});
+
+				if (i == root_attr->batch_resized.end())
+					root_attr->batch_resized.emplace_back(wd, ask_update);
+				else
+					i->second |= ask_update;
+
+				return true;
+			}
+
 			arg_resized arg;
 			arg.window_handle = wd;
 			arg.width = sz.width;
@@ -1002,7 +1126,10 @@ namespace detail
 			//Thread-Safe Required!
 			std::lock_guard<mutex_type> lock(mutex_);
 			if (impl_->wd_register.available(wd) && !wd->is_draw_through())
-				bedrock::instance().flush_surface(wd, forced, update_area);
+			{
+				if (!_m_defer_frame(wd, update_area, false))
+					bedrock::instance().flush_surface(wd, forced, update_area);
+			}
 		}
 
 		//update
@@ -1015,6 +1142,8 @@ namespace detail
 			std::lock_guard<mutex_type> lock(mutex_);
 			if (impl_->wd_register.available(wd) == false) return false;
 
+			impl_->backing_stores.expire();
+
 			if ((wd->other.category == category::flags::root) && wd->is_draw_through())
 			{
 				native_interface::refresh_window(wd->root);
@@ -1031,14 +1160,14 @@ namespace detail
 					{
 						if (!wd->try_lazy_update(redraw))
 						{
-							window_layer::paint(wd, (redraw ? paint_operation::try_refresh : paint_operation::none), false);
+							window_layer::paint(wd, (redraw ? paint_operation::try_refresh : paint_operation::none), false, update_area);
 							this->map(wd, forced, update_area);
 						}
 						return true;
 					}
 					else if (forced)
 					{
-						window_layer::paint(wd, paint_operation::none, false);
+						window_layer::paint(wd, paint_operation::none, false, update_area);
 						this->map(wd, true, update_area);
 						return true;
 					}
@@ -1057,9 +1186,17 @@ namespace detail
 			//Thread-Safe Required!
 			std::lock_guard<mutex_type> lock(mutex_);
 
-			if (this->available(root_wd) && root_wd->other.attribute.root->update_requesters.size())
+			if (!this->available(root_wd))
+				return;
+
+			auto root_attr = root_wd->other.attribute.root;
+			auto const merged = root_attr->merge_requesters;
+			root_attr->merge_requesters = false;
+
+			if (root_attr->update_requesters.size())
 			{
-				for (auto wd : root_wd->other.attribute.root->update_requesters)
+				rectangle area;
+				for (auto wd : root_attr->update_requesters)
 				{
 					using paint_operation = window_layer::paint_operation;
 					if (!this->available(wd))
@@ -1069,8 +1206,33 @@ namespace detail
 					//Redraws the widget when it has beground effect.
 					//Because the widget just redraw if it didn't have bground effect when it was inserted to the update_requesters queue
 					window_layer::paint(wd, (wd->effect.bground ? paint_operation::try_refresh : paint_operation::have_refreshed), false);
-					this->map(wd, true);
+
+					if (!merged)
+					{
+						this->map(wd, true);
+						continue;
+					}
+
+					rectangle vr;
+					if (window_layer::read_visual_rectangle(wd, vr))
+					{
+						if (area.empty())
+							area = vr;
+						else
+						{
+							auto const right = (std::max)(area.right(), vr.right());
+							auto const bottom = (std::max)(area.bottom(), vr.bottom());
+							area.x = (std::min)(area.x, vr.x);
+							area.y = (std::min)(area.y, vr.y);
+							area.width = static_cast<unsigned>(right - area.x);
+							area.height = static_cast<unsigned>(bottom - area.y);
+						}
+					}
 				}
+
+				//The windows of a geometry batch are copied to the screen in one map
+				if (!area.empty())
+					this->map(root_wd, true, &area);
 			}
 
 		}
@@ -1127,6 +1289,208 @@ namespace detail
 			wd->other.upd_state = basic_window::update_state::none;
 		}
 
+		void window_manager::backing_store_budget(std::size_t bytes)
+		{
+			//Thread-Safe Required!
+			std::lock_guard<mutex_type> lock(mutex_);
+			impl_->backing_stores.budget(bytes);
+		}
+
+		std::size_t window_manager::backing_store_budget() const
+		{
+			//Thread-Safe Required!
+			std::lock_guard<mutex_type> lock(mutex_);
+			return impl_->backing_stores.budget();
+		}
+
+		void window_manager::backing_store_threshold(std::chrono::milliseconds ms)
+		{
+			//Thread-Safe Required!
+			std::lock_guard<mutex_type> lock(mutex_);
+			impl_->backing_stores.threshold(ms);
+			impl_->backing_stores.expire();
+		}
+
+		std::chrono::milliseconds window_manager::backing_store_threshold() const
+		{
+			//Thread-Safe Required!
+			std::lock_guard<mutex_type> lock(mutex_);
+			return impl_->backing_stores.threshold();
+		}
+
+		std::size_t window_manager::backing_store_usage() const
+		{
+			//Thread-Safe Required!
+			std::lock_guard<mutex_type> lock(mutex_);
+			return backing_store_collector::usage(impl_->wd_register.queue());
+		}
+
+		void window_manager::transient_backing(basic_window* wd, bool enabled)
+		{
+			//Thread-Safe Required!
+			std::lock_guard<mutex_type> lock(mutex_);
+			if (impl_->wd_register.available(wd))
+				impl_->backing_stores.transient(wd, enabled);
+		}
+
+		basic_window* window_manager::begin_geometry_batch(basic_window* wd)
+		{
+			//Thread-Safe Required!
+			std::lock_guard<mutex_type> lock(mutex_);
+			if (!impl_->wd_register.available(wd))
+				return nullptr;
+
+			auto root_attr = wd->root_widget->other.attribute.root;
+			if (0 == root_attr->geometry_batch++)
+			{
+				root_attr->lazy_update_before_batch = root_attr->lazy_update;
+				root_attr->lazy_update = true;
+			}
+			return wd->root_widget;
+		}
+
+		void window_manager::commit_geometry_batch(basic_window* root_wd)
+		{
+			//Thread-Safe Required!
+			std::lock_guard<mutex_type> lock(mutex_);
+			if (!impl_->wd_register.available(root_wd))
+				return;
+
+			auto root_attr = root_wd->other.attribute.root;
+			if ((0 == root_attr->geometry_batch) || (--root_attr->geometry_batch))
+				return;
+
+			//The batch is still open while the events are emitted, the windows which are resized by the handlers,
+			//such as the fields of a place, are deferred again.
+			++root_attr->geometry_batch;
+
+			auto & brock = bedrock::instance();
+			try
+			{
+				while (!root_attr->batch_resized.empty())
+				{
+					auto resized = std::move(root_attr->batch_resized);
+					root_attr->batch_resized.clear();
+
+					for (auto & rs : resized)
+					{
+						if (!impl_->wd_register.available(rs.first))
+							continue;
+
+						arg_resized arg;
+						arg.window_handle = rs.first;
+						arg.width = rs.first->dimension.width;
+						arg.height = rs.first->dimension.height;
+						brock.emit(event_code::resized, rs.first, arg, rs.second, brock.get_thread_context());
+
+						//The root window may be closed by a handler
+						if (!impl_->wd_register.available(root_wd))
+							return;
+					}
+				}
+			}
+			catch (...)
+			{
+				//Closes the batch, otherwise the root window would stay in the lazy update.
+				if (impl_->wd_register.available(root_wd))
+				{
+					root_attr->batch_resized.clear();
+					root_attr->geometry_batch = 0;
+					root_attr->lazy_update = root_attr->lazy_update_before_batch;
+				}
+				throw;
+			}
+
+			root_attr->geometry_batch = 0;
+			root_attr->lazy_update = root_attr->lazy_update_before_batch;
+			root_attr->merge_requesters = true;
+
+			//In an event, the requesters are left to the flush at the end of the event, and they are cleared by the root_guard.
+			if (!root_attr->lazy_update)
+			{
+				update_requesters(root_wd);
+				root_attr->update_requesters.clear();
+			}
+		}
+
+		void window_manager::frame_rate(basic_window* wd, unsigned hz)
+		{
+			//Thread-Safe Required!
+			std::lock_guard<mutex_type> lock(mutex_);
+			if (!impl_->wd_register.available(wd))
+				return;
+
+			auto rrt = root_runtime(wd->root);
+			if (nullptr == rrt)
+				return;
+
+			if (hz)
+			{
+				if (!rrt->frame)
+					rrt->frame.reset(new frame_scheduler{ rrt->window });
+			}
+			else if (rrt->frame)
+			{
+				//Flushes the pending updates before the frame pacing is disabled.
+				if (rrt->frame->pending())
+					_m_commit_frame(rrt);
+			}
+			else
+				return;
+
+			rrt->frame->rate(hz);
+		}
+
+		unsigned window_manager::frame_rate(basic_window* wd) const
+		{
+			//Thread-Safe Required!
+			std::lock_guard<mutex_type> lock(mutex_);
+			if (impl_->wd_register.available(wd))
+			{
+				auto rrt = root_runtime(wd->root);
+				if (rrt && rrt->frame)
+					return rrt->frame->rate();
+			}
+			return 0;
+		}
+
+		void window_manager::request_frame(basic_window* wd)
+		{
+			//Thread-Safe Required!
+			std::lock_guard<mutex_type> lock(mutex_);
+			if (!impl_->wd_register.available(wd))
+				return;
+
+			//Refreshes the window immediately if the frame pacing is disabled.
+			if (!_m_defer_frame(wd, nullptr, true))
+				update(wd, true, false);
+		}
+
+		frame_statistics window_manager::frame_stats(basic_window* wd) const
+		{
+			//Thread-Safe Required!
+			std::lock_guard<mutex_type> lock(mutex_);
+			if (impl_->wd_register.available(wd))
+			{
+				auto rrt = root_runtime(wd->root);
+				if (rrt && rrt->frame)
+					return rrt->frame->statistics();
+			}
+			return{};
+		}
+
+		void window_manager::commit_frame(basic_window* root_wd)
+		{
+			//Thread-Safe Required!
+			std::lock_guard<mutex_type> lock(mutex_);
+			if (!impl_->wd_register.available(root_wd))
+				return;
+
+			auto rrt = root_runtime(root_wd->root);
+			if (rrt && rrt->frame && rrt->frame->pending())
+				_m_commit_frame(rrt);
+		}
+
 		bool window_manager::set_parent(basic_window* wd, basic_window* newpa)
 		{
 			//Thread-Safe Required!
@@ -1528,6 +1892,9 @@ namespace detail
 			auto * const wdpa = wd->parent;
 
 			bool established = (for_new && (wdpa != for_new));
+
+			//The ranks of the widgets are changed
+			_m_invalidate_hits(wd);
 			decltype(for_new->root_widget->other.attribute.root) pa_root_attr = nullptr;
 
 			if (established)
@@ -1652,7 +2019,10 @@ namespace detail
 				wd->root_graph = for_new->root_graph;
 				wd->root_widget = for_new->root_widget;
 
-				wd->pos_owner.x = wd->pos_owner.y = 0;
+				{
+					registry_write_guard rwg{ *this };
+					wd->pos_owner.x = wd->pos_owner.y = 0;
+				}
 
 				auto delta_pos = wd->pos_root - for_new->pos_root;
 
@@ -1682,6 +2052,7 @@ namespace detail
 				};
 
 				set_pos_root(wd, delta_pos);
+				_m_invalidate_hits(wd);
 
 				for (auto & keys : sk_holder)
 					register_shortkey(keys.first, keys.second);
@@ -1707,6 +2078,13 @@ namespace detail
 			//remove the window from edge nimbus effect when it is destroying
 			edge_nimbus_renderer::instance().erase(wd);
 
+			//remove the window from the pending frame of its root
+			auto rrt = root_runtime(wd->root);
+			if (rrt && rrt->frame)
+				rrt->frame->erase(wd);
+
+			impl_->backing_stores.erase(wd);
+
 			arg_destroy arg;
 			arg.window_handle = wd;
 			brock.emit(event_code::destroy, wd, arg, true, brock.get_thread_context());
@@ -1732,7 +2110,10 @@ namespace detail
 			wd->widget_notifier->destroy();
 
 			if(wd->other.category != category::flags::root)	//Not a root window
+			{
+				registry_write_guard rwg{ *this };
 				impl_->wd_register.remove(wd);
+			}
 
 			//Release graphics immediately.
 			wd->drawer.graphics.release();
@@ -1782,37 +2163,67 @@ namespace detail
 			}
 		}
 
-		//_m_find
-		//@brief: find a window on root window through a given root coordinate.
-		//		the given root coordinate must be in the rectangle of wnd.
-		basic_window* window_manager::_m_find(basic_window* wd, const point& pos)
+		//_m_effective, test if the window is a handle of window that specified by (root_x, root_y)
+		bool window_manager::_m_effective(basic_window* wd, const point& root_pos)
 		{
-			if(!wd->visible)
-				return nullptr;
+			if(wd == nullptr || false == wd->visible)	return false;
+			return rectangle{ wd->pos_root, wd->dimension }.is_hit(root_pos);
+		}
+
+		void window_manager::_m_invalidate_hits(basic_window* wd)
+		{
+			auto rrt = root_runtime(wd->root);
+			if (rrt)
+				rrt->hits.invalidate();
+		}
+
+		void window_manager::_m_update_hits(basic_window* wd, bool with_children)
+		{
+			auto rrt = root_runtime(wd->root);
+			if (rrt)
+				rrt->hits.update(wd, with_children);
+		}
 
-			if (!wd->children.empty())
+		bool window_manager::_m_defer_frame(basic_window* wd, const rectangle* update_area, bool redraw)
+		{
+			auto rrt = root_runtime(wd->root);
+			if (!(rrt && rrt->frame && rrt->frame->enabled()))
+				return false;
+
+			rectangle vr;
+			if (window_layer::read_visual_rectangle(wd, vr))
 			{
-				auto index = wd->children.size();
+				if (update_area && !overlap(*update_area, rectangle{ vr }, vr))
+					return true;
 
-				do
-				{
-					auto child = wd->children[--index];
-					if ((child->other.category != category::flags::root) && _m_effective(child, pos))
-					{
-						child = _m_find(child, pos);
-						if (child)
-							return child;
-					}
-				} while (0 != index);
+				if (rrt->frame->request(wd, vr, redraw))
+					_m_commit_frame(rrt);
 			}
-			return wd;
+			return true;
 		}
 
-		//_m_effective, test if the window is a handle of window that specified by (root_x, root_y)
-		bool window_manager::_m_effective(basic_window* wd, const point& root_pos)
+		void window_manager::_m_commit_frame(root_misc* rrt)
 		{
-			if(wd == nullptr || false == wd->visible)	return false;
-			return rectangle{ wd->pos_root, wd->dimension }.is_hit(root_pos);
+			auto const started = frame_scheduler::clock_type::now();
+
+			std::vector<frame_scheduler::dirty_window> dirty;
+			auto damage = rrt->frame->take(dirty);
+
+			for (auto & dw : dirty)
+			{
+				if (dw.redraw && impl_->wd_register.available(dw.window) && dw.window->displayed())
+					window_layer::paint(dw.window, window_layer::paint_operation::try_refresh, false);
+			}
+
+			//Copies the damaged rectangles only, rather than their bounding rectangle
+			auto root_wd = rrt->window;
+			if (!root_wd->is_draw_through())
+			{
+				for (auto & r : damage)
+					bedrock::instance().flush_surface(root_wd, true, &r);
+			}
+
+			rrt->frame->finish(started);
 		}
 	//end class window_manager
 }//end namespace detail
@@ -2,7 +2,7 @@
 #define NANA_WINDOW_REGISTER_HEADER_INCLUDED
 
 #include "basic_window.hpp"
-#include <set>
+#include <cstdint>
 #include <vector>
 #include <algorithm> //std::find
 
@@ -10,100 +10,149 @@ namespace nana
 {
 	namespace detail
 	{
-		template<typename Key, typename Value, std::size_t CacheSize>
-		class cache
+		/// An open addressing hash set of window handles.
+		/**
+		 * Validating a handle is a single probe sequence in a flat array, there is no tree walk and no allocation.
+		 * The linear probing keeps the sequence in a few cache lines. The erased slots are marked as deleted and
+		 * are reused by the insertion, they are dropped when the table is rehashed.
+		 */
+		class window_handle_set
 			: noncopyable
 		{
 		public:
-			typedef Key	key_type;
-			typedef Value value_type;
-			typedef std::pair<key_type, value_type> pair_type;
-			typedef std::size_t size_type;
+			using value_type = basic_window*;
 
-			cache()
-				:addr_(reinterpret_cast<pair_type*>(::operator new(sizeof(pair_type) * CacheSize)))
+			window_handle_set()
+				: slots_(min_capacity, nullptr)
+			{}
+
+			bool insert(value_type wd)
 			{
-				for (std::size_t i = 0; i < CacheSize; ++i)
+				if ((used_ + 1) * 4 > slots_.size() * 3)
+					_m_rehash(size_ + 1);
+
+				auto const mask = slots_.size() - 1;
+				std::size_t reusable = npos;
+				for (auto i = _m_hash(wd); ; i = (i + 1) & mask)
 				{
-					bitmap_[i] = 0;
-					seq_[i] = nana::npos;
+					auto & slot = slots_[i];
+					if (slot == wd)
+						return false;
+
+					if (slot == _m_deleted())
+					{
+						if (reusable == npos)
+							reusable = i;
+					}
+					else if (nullptr == slot)
+					{
+						if (reusable == npos)
+						{
+							slot = wd;
+							++used_;
+						}
+						else
+							slots_[reusable] = wd;
+
+						++size_;
+						return true;
+					}
 				}
 			}
 
-			~cache()
+			bool erase(value_type wd)
 			{
-				for (std::size_t i = 0; i < CacheSize; ++i)
-				{
-					if (bitmap_[i])
-						addr_[i].~pair_type();
-				}
+				auto i = _m_find(wd);
+				if (npos == i)
+					return false;
 
-				::operator delete(addr_);
+				slots_[i] = _m_deleted();
+				--size_;
+				return true;
 			}
 
-			bool insert(key_type k, value_type v)
+			bool contains(value_type wd) const
 			{
-				size_type pos = _m_find_key(k);
-				if (pos != nana::npos)
-				{
-					addr_[pos].second = v;
-				}
-				else
-				{
-					//No key exists
-					pos = _m_find_pos();
-
-					if (pos == nana::npos)
-					{	//No room, and remove the last pair
-						pos = seq_[CacheSize - 1];
-						(addr_ + pos)->~pair_type();
-					}
-
-					if (seq_[0] != nana::npos)
-					{//Need to move
-						for (int i = CacheSize - 1; i > 0; --i)
-							seq_[i] = seq_[i - 1];
-					}
+				return (npos != _m_find(wd));
+			}
 
-					seq_[0] = pos;
+			std::size_t size() const
+			{
+				return size_;
+			}
+		private:
+			static constexpr std::size_t min_capacity = 64;
+			static constexpr unsigned min_capacity_bits = 6;
 
-					new (addr_ + pos) pair_type(k, v);
-					bitmap_[pos] = 1;
-				}
-				return v;
+			static value_type _m_deleted()
+			{
+				//A basic_window object is never placed at this address
+				return reinterpret_cast<value_type>(static_cast<std::uintptr_t>(1));
 			}
 
-			value_type * get(key_type k)
+			/// Fibonacci hashing, the slot is the top log2(capacity) bits of the product.
+			/**
+			 * The addresses of the windows are often an arithmetic progression, because they are allocated one by one. The plain
+			 * product maps a progression to a regular lattice of slots, which forms long clusters with the linear probing. So the
+			 * product of the address is folded once before it's multiplied for the slot.
+			 */
+			std::size_t _m_hash(value_type wd) const
 			{
-				size_type pos = _m_find_key(k);
-				if (pos != nana::npos)
-					return &(addr_[pos].second);
-				return 0;
+				constexpr std::uint64_t golden = 0x9E3779B97F4A7C15ull;
+
+				auto key = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(wd)) * golden;
+				key ^= (key >> 32);
+				return static_cast<std::size_t>((key * golden) >> shift_);
 			}
-		private:
-			size_type _m_find_key(key_type k) const
+
+			std::size_t _m_find(value_type wd) const
 			{
-				for (std::size_t i = 0; i < CacheSize; ++i)
+				if (nullptr == wd || _m_deleted() == wd)
+					return npos;
+
+				auto const mask = slots_.size() - 1;
+				for (auto i = _m_hash(wd); ; i = (i + 1) & mask)
 				{
-					if (bitmap_[i] && (addr_[i].first == k))
+					auto const slot = slots_[i];
+					if (slot == wd)
 						return i;
+
+					if (nullptr == slot)
+						return npos;
 				}
-				return nana::npos;
 			}
 
-			size_type _m_find_pos() const
+			void _m_rehash(std::size_t count)
 			{
-				for (std::size_t i = 0; i < CacheSize; ++i)
+				auto capacity = min_capacity;
+				unsigned bits = min_capacity_bits;
+				for (; count * 2 > capacity; ++bits)
+					capacity <<= 1;
+
+				std::vector<value_type> slots(capacity, nullptr);
+				slots.swap(slots_);
+
+				used_ = size_;
+				shift_ = 64 - bits;
+
+				auto const mask = capacity - 1;
+				for (auto wd : slots)
 				{
-					if (bitmap_[i] == 0)
-						return i;
+					if ((nullptr == wd) || (_m_deleted() == wd))
+						continue;
+
+					auto i = _m_hash(wd);
+					while (slots_[i])
+						i = (i + 1) & mask;
+
+					slots_[i] = wd;
 				}
-				return nana::npos;
 			}
 		private:
-			char bitmap_[CacheSize];
-			size_type seq_[CacheSize];
-			pair_type * addr_;
+			std::vector<value_type> slots_;
+			unsigned shift_{ 64 - min_capacity_bits };	///< 64 - log2(capacity), the hash takes the top bits of the product.
+			std::size_t size_{ 0 };		///< The number of handles.
+			std::size_t used_{ 0 };		///< The number of slots which are not empty, including the deleted slots.
 		};
 
 		class window_register
@@ -125,7 +174,6 @@ namespace nana
 				if (wd)
 				{
 					base_.insert(wd);
-					wdcache_.insert(wd, true);
 
 					if (category::flags::root == wd->other.category)
 						queue_.push_back(wd);
@@ -141,7 +189,6 @@ namespace nana
 			{
 				if (base_.erase(wd))
 				{
-					wdcache_.insert(wd, false);
 					trash_.push_back(wd);
 
 					if (category::flags::root == wd->other.category)
@@ -188,20 +235,18 @@ namespace nana
 				return base_.size();
 			}
 
-			bool available(window_handle_type wd) const
+			/// Determines whether the window is registered, it doesn't modify the register and is safe for concurrent readers.
+			bool contains(window_handle_type wd) const
 			{
-				if (nullptr == wd)
-					return false;
-
-				auto exists = wdcache_.get(wd);
-				if (exists)
-					return *exists;
+				return base_.contains(wd);
+			}
 
-				return wdcache_.insert(wd, (base_.count(wd) != 0));
+			bool available(window_handle_type wd) const
+			{
+				return base_.contains(wd);
 			}
 		private:
-			mutable cache<window_handle_type, bool, 5> wdcache_;
-			std::set<window_handle_type> base_;
+			window_handle_set base_;
 			std::vector<window_handle_type> trash_;
 			std::vector<window_handle_type> queue_;
 		};
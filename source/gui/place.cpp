@@ -2668,6 +2668,9 @@ namespace nana
 	{
 		if (root_division && window_handle)
 		{
+			//The fields are moved and resized in a batch, they are painted once when the batch is committed.
+			API::geometry_batch batch{ window_handle };
+
 			root_division->field_area.dimension(API::window_size(window_handle));
 
 			if (root_division->field_area.empty())
@@ -2700,6 +2703,9 @@ namespace nana
 				//shouldn't break the visibility of panels that are maintained by tabbar.
 				field.second->visible(is_show, false);
 			}
+
+			//Commits explicitly, so that the exceptions of the resized handlers are propagated.
+			batch.commit();
 		}
 	}
 
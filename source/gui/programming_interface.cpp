@@ -12,6 +12,7 @@
  */
 
 #include "detail/basic_window.hpp"
+#include "detail/event_profiler.hpp"
 #include <nana/gui/programming_interface.hpp>
 #include <nana/gui/detail/bedrock.hpp>
 #include <nana/gui/detail/window_manager.hpp>
@@ -21,6 +22,8 @@
 #include <nana/gui/widgets/widget.hpp>
 #include <nana/gui/detail/events_operation.hpp>
 
+#include <fstream>
+
 #include "../../source/detail/platform_abstraction.hpp"
 #ifdef NANA_X11
 #	include "../../source/detail/posix/platform_spec.hpp"
@@ -40,6 +43,19 @@ namespace nana
 			{
 				return bedrock.wd_manager();
 			}
+
+			void update_damage(window wd, bool redraw, bool forced, const rectangle& damage)
+			{
+				internal_scope_guard lock;
+				if (wd_manager().available(wd))
+				{
+					//The window manager requires the area in the coordinate of the root window
+					rectangle r{ damage };
+					r.x += wd->pos_root.x;
+					r.y += wd->pos_root.y;
+					wd_manager().update(wd, redraw, forced, &r);
+				}
+			}
 		}
 	}
 
@@ -130,7 +146,7 @@ namespace API
 			{
 				if (wd->effect.edge_nimbus == effects::edge_nimbus::none)
 				{
-					cont.emplace_back(basic_window::edge_nimbus_action{ wd, false});
+					cont.emplace_back(basic_window::edge_nimbus_action{ wd, false, rectangle{} });
 				}
 				wd->effect.edge_nimbus = static_cast<effects::edge_nimbus>(static_cast<unsigned>(en) | static_cast<unsigned>(wd->effect.edge_nimbus));
 			}
@@ -168,6 +184,9 @@ namespace API
 			if(nullptr == new_effect_ptr)
 				return;
 
+			//The effect blends the graphics of the widget, it should be kept.
+			transient_backing(wd, false);
+
 			delete wd->effect.bground;
 			wd->effect.bground = new_effect_ptr;
 			wd->effect.bground_fade_rate = fade_rate;
@@ -300,7 +319,11 @@ namespace API
 		{
 			internal_scope_guard lock;
 			if(is_window(wd))
+			{
+				//The caller draws on the graphics, a released transient graphics is made for it.
+				wd->drawer.acquire_transient();
 				return &(wd->drawer.graphics);
+			}
 			return nullptr;
 		}
 
@@ -525,7 +548,8 @@ namespace API
 
 	bool is_window(window wd)
 	{
-		return restrict::wd_manager().available(wd);
+		internal_shared_guard lock;
+		return restrict::wd_manager().registered(wd);
 	}
 
 	bool is_destroying(window wd)
@@ -664,8 +688,8 @@ namespace API
 
 	nana::point window_position(window wd)
 	{
-		internal_scope_guard lock;
-		if(is_window(wd))
+		internal_shared_guard lock;
+		if(restrict::wd_manager().registered(wd))
 		{
 			return ( (wd->other.category == category::flags::root) ?
 				interface_type::window_position(wd->root) : wd->pos_owner);
@@ -759,6 +783,35 @@ namespace API
 		return{ r.width, r.height };
 	}
 
+	//class geometry_batch
+	geometry_batch::geometry_batch(window wd)
+		: window_(restrict::wd_manager().begin_geometry_batch(wd))
+	{
+	}
+
+	geometry_batch::~geometry_batch()
+	{
+		//The destructor may be called while an exception is unwinding the stack, it shall not throw.
+		try
+		{
+			commit();
+		}
+		catch (...)
+		{
+		}
+	}
+
+	void geometry_batch::commit()
+	{
+		if (window_)
+		{
+			auto root_wd = window_;
+			window_ = nullptr;
+			restrict::wd_manager().commit_geometry_batch(root_wd);
+		}
+	}
+	//end class geometry_batch
+
 	void window_size(window wd, const size& sz)
 	{
 		internal_scope_guard lock;
@@ -819,16 +872,16 @@ namespace API
 
 	std::optional<rectangle> window_rectangle(window wd)
 	{
-		internal_scope_guard lock;
-		if (is_window(wd))
+		internal_shared_guard lock;
+		if (restrict::wd_manager().registered(wd))
 			return rectangle(wd->pos_owner, wd->dimension);
 		return{};
 	}
 
 	bool get_window_rectangle(window wd, rectangle& r)
 	{
-		internal_scope_guard lock;
-		if(is_window(wd))
+		internal_shared_guard lock;
+		if(restrict::wd_manager().registered(wd))
 		{
 			r = rectangle(wd->pos_owner, wd->dimension);
 			return true;
@@ -902,6 +955,185 @@ namespace API
 		restrict::wd_manager().update(wd, false, true);
 	}
 
+	void refresh_window(window wd, const rectangle& damage)
+	{
+		restrict::update_damage(wd, true, false, damage);
+	}
+
+	void update_window(window wd, const rectangle& damage)
+	{
+		restrict::update_damage(wd, false, true, damage);
+	}
+
+	bool transient_backing(window wd, bool enabled)
+	{
+		internal_scope_guard lock;
+		if (!restrict::wd_manager().available(wd))
+			return false;
+
+		//The bground effect blends the graphics of the widget, it should be kept.
+		if ((category::flags::widget != wd->other.category) || (enabled && wd->effect.bground))
+			return false;
+
+		if (wd->flags.transient_backing != enabled)
+		{
+			if (enabled)
+			{
+				wd->flags.transient_backing = true;
+				wd->drawer.release_transient();
+			}
+			else
+			{
+				//Makes the graphics before the mode is disabled, it is kept from now on.
+				wd->drawer.acquire_transient();
+				wd->flags.transient_backing = false;
+			}
+			restrict::wd_manager().transient_backing(wd, enabled);
+		}
+		return true;
+	}
+
+	bool transient_backing(window wd)
+	{
+		internal_scope_guard lock;
+		return (restrict::wd_manager().available(wd) && wd->flags.transient_backing);
+	}
+
+	void translucent(window wd, bool enabled)
+	{
+		internal_scope_guard lock;
+		if (restrict::wd_manager().available(wd))
+			wd->flags.translucent = enabled;
+	}
+
+	bool translucent(window wd)
+	{
+		internal_scope_guard lock;
+		return (restrict::wd_manager().available(wd) && wd->flags.translucent);
+	}
+
+	void backing_store_budget(std::size_t bytes)
+	{
+		restrict::wd_manager().backing_store_budget(bytes);
+	}
+
+	std::size_t backing_store_budget()
+	{
+		return restrict::wd_manager().backing_store_budget();
+	}
+
+	void backing_store_threshold(std::chrono::milliseconds threshold)
+	{
+		restrict::wd_manager().backing_store_threshold(threshold);
+	}
+
+	std::chrono::milliseconds backing_store_threshold()
+	{
+		return restrict::wd_manager().backing_store_threshold();
+	}
+
+	std::size_t backing_store_usage()
+	{
+		return restrict::wd_manager().backing_store_usage();
+	}
+
+	void frame_rate(window wd, unsigned hz)
+	{
+		restrict::wd_manager().frame_rate(wd, hz);
+	}
+
+	unsigned frame_rate(window wd)
+	{
+		return restrict::wd_manager().frame_rate(wd);
+	}
+
+	void request_frame(window wd)
+	{
+		restrict::wd_manager().request_frame(wd);
+	}
+
+	frame_statistics frame_stats(window wd)
+	{
+		return restrict::wd_manager().frame_stats(wd);
+	}
+
+	namespace profiling
+	{
+		bool enabled()
+		{
+#ifdef NANA_ENABLE_EVENT_PROFILING
+			return true;
+#else
+			return false;
+#endif
+		}
+
+		latency_histogram latency(event_code evt_code, event_phase phase)
+		{
+#ifdef NANA_ENABLE_EVENT_PROFILING
+			return ::nana::detail::event_profiler::instance().histogram(evt_code, phase);
+#else
+			static_cast<void>(evt_code);	//eliminate unused parameter compiler warning.
+			static_cast<void>(phase);
+			return{};
+#endif
+		}
+
+		void reset()
+		{
+#ifdef NANA_ENABLE_EVENT_PROFILING
+			::nana::detail::event_profiler::instance().reset();
+#endif
+		}
+
+		void dump(std::ostream& os)
+		{
+			const char* const code_names[] = {
+				"click", "dbl_click", "mouse_enter", "mouse_move", "mouse_leave", "mouse_down", "mouse_up",
+				"mouse_wheel", "mouse_drop", "expose", "resizing", "resized", "move", "unload", "destroy",
+				"focus", "key_press", "key_char", "key_release", "shortkey", "elapse"
+			};
+
+			const char* const phase_names[] = { "handler", "refresh", "flush" };
+
+			static_assert(sizeof(code_names) / sizeof(code_names[0]) == static_cast<std::size_t>(event_code::end), "the names of event code are mismatched");
+			static_assert(sizeof(phase_names) / sizeof(phase_names[0]) == static_cast<std::size_t>(event_phase::end), "the names of event phase are mismatched");
+
+			if (!enabled())
+			{
+				os << "event profiling is disabled, rebuild nana with NANA_ENABLE_EVENT_PROFILING" << std::endl;
+				return;
+			}
+
+			os << "event\tphase\tsamples\ttotal(us)\tavg(us)\tp50(us)\tp99(us)\tmax(us)\tslowest widget" << std::endl;
+
+			for (std::size_t code = 0; code < static_cast<std::size_t>(event_code::end); ++code)
+			{
+				for (std::size_t phase = 0; phase < static_cast<std::size_t>(event_phase::end); ++phase)
+				{
+					auto hist = latency(static_cast<event_code>(code), static_cast<event_phase>(phase));
+					if (0 == hist.samples)
+						continue;
+
+					os << code_names[code] << '\t' << phase_names[phase] << '\t' << hist.samples << '\t' << hist.total.count()
+						<< '\t' << hist.total.count() / static_cast<long long>(hist.samples)
+						<< '\t' << hist.percentile(0.5).count() << '\t' << hist.percentile(0.99).count() << '\t' << hist.max.count()
+						<< '\t' << (hist.slowest_widget ? hist.slowest_widget : "-") << std::endl;
+				}
+			}
+		}
+
+		bool dump(const std::string& file_utf8)
+		{
+			std::ofstream ofs{ to_osmbstr(file_utf8) };
+			if (!ofs)
+				return false;
+
+			dump(ofs);
+			return true;
+		}
+	}//end namespace profiling
+
 	void window_caption(window wd, const std::string& title_utf8)
 	{
 		throw_not_utf8(title_utf8);
@@ -22,19 +22,29 @@
 #include <list>
 #include <deque>
 #include <stdexcept>
+#include <exception>
 #include <map>
+#include <mutex>
 #include <iostream>
+#include <cstdint>
+#include <limits>
 
 #include <nana/gui/widgets/listbox.hpp>
 #include <nana/gui/widgets/panel.hpp>	//for inline widget
 
 #include <nana/gui/layout_utility.hpp>
 #include <nana/gui/element.hpp>
+#include <nana/gui/timer.hpp>
 #include <nana/paint/text_renderer.hpp>
 #include <nana/system/dataexch.hpp>
 #include <nana/system/platform.hpp>
 #include "skeletons/content_view.hpp"
 
+#ifndef STD_THREAD_NOT_SUPPORTED
+#	include <system_error>
+#	include <thread>
+#endif
+
 namespace nana
 {
 	static void check_range(std::size_t pos, std::size_t size)
@@ -68,6 +78,115 @@ namespace nana
 				model_interface* const model_ptr_;
 			};
 
+			/// The container of a virtual category, it only knows the number of items.
+			class virtual_container
+				: public container_interface
+			{
+			public:
+				using fetcher_type = std::function<std::vector<cell>(std::size_t)>;
+
+				virtual_container(std::size_t rows, fetcher_type fetcher)
+					: rows_(rows), fetcher_(std::move(fetcher))
+				{
+				}
+
+				void resize(std::size_t rows) noexcept
+				{
+					rows_ = rows;
+				}
+			private:
+				void clear() override
+				{
+					throw std::runtime_error("nana::listbox disallow to remove items because of immutable model");
+				}
+
+				void erase(std::size_t) override
+				{
+					throw std::runtime_error("nana::listbox disallow to remove items because of immutable model");
+				}
+
+				std::size_t size() const override
+				{
+					return rows_;
+				}
+
+				bool immutable() const override
+				{
+					return true;
+				}
+
+				void emplace(std::size_t) override
+				{
+					throw std::runtime_error("nana::listbox disallow to insert items because of immutable model");
+				}
+
+				void emplace_back() override
+				{
+					throw std::runtime_error("nana::listbox disallow to insert items because of immutable model");
+				}
+
+				void assign(std::size_t, const std::vector<cell>&) override
+				{
+					throw std::runtime_error("nana::listbox disallow to modify items because of immutable model");
+				}
+
+				std::vector<cell> to_cells(std::size_t pos) const override
+				{
+					return fetcher_(pos);
+				}
+
+				bool push_back(const const_virtual_pointer&) override
+				{
+					throw std::runtime_error("nana::listbox disallow to insert items because of immutable model");
+				}
+
+				void * pointer() override
+				{
+					return nullptr;
+				}
+
+				const void* pointer() const override
+				{
+					return nullptr;
+				}
+			private:
+				std::size_t rows_;
+				fetcher_type fetcher_;
+			};
+
+			class virtual_model_container
+				: public model_interface
+			{
+			public:
+				virtual_model_container(std::size_t rows, virtual_container::fetcher_type fetcher)
+					: container_(rows, std::move(fetcher))
+				{
+				}
+
+				void lock() override
+				{
+					mutex_.lock();
+				}
+
+				void unlock() override
+				{
+					mutex_.unlock();
+				}
+
+				virtual_container* container() noexcept override
+				{
+					return &container_;
+				}
+
+				const virtual_container* container() const noexcept override
+				{
+					return &container_;
+				}
+			private:
+				std::recursive_mutex mutex_;
+				virtual_container container_;
+			};
+
 
 			//struct cell
 				cell::format::format(const ::nana::color& bgcolor, const ::nana::color& fgcolor) noexcept
@@ -116,6 +235,47 @@ namespace nana
 				}
 			//end struct cell
 
+			//class model_feed
+				void model_feed::push(kinds kind, std::size_t pos, modifier modify)
+				{
+					std::lock_guard<std::mutex> lock(mutex_);
+					operations_.push_back(operation{ kind, pos, std::move(modify) });
+				}
+
+				bool model_feed::pop(operation& op)
+				{
+					std::lock_guard<std::mutex> lock(mutex_);
+					if (operations_.empty())
+						return false;
+
+					op = std::move(operations_.front());
+					operations_.pop_front();
+					return true;
+				}
+
+				std::size_t model_feed::pending()
+				{
+					std::lock_guard<std::mutex> lock(mutex_);
+					return operations_.size();
+				}
+
+				std::shared_ptr<void> model_feed::token()
+				{
+					auto tk = token_.lock();
+					if (!tk)
+					{
+						tk = std::make_shared<char>();
+						token_ = tk;
+					}
+					return tk;
+				}
+
+				bool model_feed::feeding() const
+				{
+					return !token_.expired();
+				}
+			//end class model_feed
+
             // Essence of the columns Header
 			class es_header
 			{
@@ -602,15 +762,190 @@ namespace nana
 			};
 
 
+			/// The cells of an item, which are stored in a block of memory.
+			/**
+			 * The block begins with the number of cells and the end offsets of their texts, and the texts follow them
+			 * without terminators, so that an item costs one allocation rather than a vector and a string for each cell.
+			 * The custom formats are rarely used, they are stored in a table which is allocated when a cell has one.
+			 */
+			class cell_row
+			{
+				using offset_type = std::uint32_t;
+				using format_table = std::vector<std::pair<std::size_t, cell::format>>;
+			public:
+				cell_row() noexcept = default;
+				cell_row(cell_row&&) noexcept = default;
+				cell_row& operator=(cell_row&&) noexcept = default;
+
+				cell_row(const cell_row& r)
+					: formats_(r.formats_ ? std::make_unique<format_table>(*r.formats_) : nullptr)
+				{
+					if (r.block_)
+					{
+						auto const units = r._m_units();
+						block_.reset(new offset_type[units]);
+						std::copy(r.block_.get(), r.block_.get() + units, block_.get());
+					}
+				}
+
+				explicit cell_row(const std::vector<cell>& cells)
+				{
+					assign(cells);
+				}
+
+				cell_row& operator=(const cell_row& r)
+				{
+					if (this != &r)
+						*this = cell_row{ r };
+					return *this;
+				}
+
+				std::size_t size() const noexcept
+				{
+					return (block_ ? block_[0] : 0);
+				}
+
+				/// Returns the text of a cell which is not null-terminated, the cell must exist.
+				const char* data(std::size_t col) const noexcept
+				{
+					return _m_chars() + _m_begin(col);
+				}
+
+				/// Returns the length of the text of a cell, the cell must exist.
+				std::size_t length(std::size_t col) const noexcept
+				{
+					return block_[col + 1] - _m_begin(col);
+				}
+
+				/// Returns the text of a cell, or an empty text if the cell doesn't exist.
+				std::string text(std::size_t col) const
+				{
+					if (col < size())
+						return std::string(data(col), length(col));
+					return{};
+				}
+
+				/// Returns the custom format of a cell, or nullptr if the cell doesn't have one.
+				const cell::format* format(std::size_t col) const noexcept
+				{
+					if (formats_)
+					{
+						for (auto & m : *formats_)
+						{
+							if (m.first == col)
+								return &m.second;
+						}
+					}
+					return nullptr;
+				}
+
+				std::vector<cell> to_cells() const
+				{
+					std::vector<cell> cells;
+					cells.reserve(size());
+					for (std::size_t col = 0; col < size(); ++col)
+						cells.emplace_back(text(col));
+
+					if (formats_)
+					{
+						for (auto & m : *formats_)
+							cells[m.first].custom_format = std::make_unique<cell::format>(m.second);
+					}
+					return cells;
+				}
+
+				void assign(const std::vector<cell>& cells)
+				{
+					std::size_t chars = 0;
+					std::unique_ptr<format_table> formats;
+					for (std::size_t col = 0; col < cells.size(); ++col)
+					{
+						chars += cells[col].text.size();
+						if (cells[col].custom_format)
+						{
+							if (!formats)
+								formats.reset(new format_table);
+
+							formats->emplace_back(col, *cells[col].custom_format);
+						}
+					}
+
+					if ((std::max)(chars, cells.size()) >= (std::numeric_limits<offset_type>::max)())
+						throw std::length_error("listbox: the texts of an item are too long");
+
+					std::unique_ptr<offset_type[]> block;
+					if (!cells.empty())
+					{
+						auto const head = cells.size() + 1;
+						block.reset(new offset_type[head + _m_units_of(chars)]);
+						block[0] = static_cast<offset_type>(cells.size());
+
+						auto const chars_ptr = reinterpret_cast<char*>(block.get() + head);
+						offset_type end = 0;
+						for (std::size_t col = 0; col < cells.size(); ++col)
+						{
+							auto & text = cells[col].text;
+							std::copy(text.begin(), text.end(), chars_ptr + end);
+							end += static_cast<offset_type>(text.size());
+							block[col + 1] = end;
+						}
+					}
+
+					block_ = std::move(block);
+					formats_ = std::move(formats);
+				}
+			private:
+				static std::size_t _m_units_of(std::size_t chars) noexcept
+				{
+					return (chars + sizeof(offset_type) - 1) / sizeof(offset_type);
+				}
+
+				std::size_t _m_units() const noexcept
+				{
+					auto const count = block_[0];
+					return count + 1 + _m_units_of(block_[count]);
+				}
+
+				std::size_t _m_begin(std::size_t col) const noexcept
+				{
+					return (col ? block_[col] : 0);
+				}
+
+				const char* _m_chars() const noexcept
+				{
+					return reinterpret_cast<const char*>(block_.get() + block_[0] + 1);
+				}
+			private:
+				std::unique_ptr<offset_type[]> block_;	///< Null if the item doesn't have a cell.
+				std::unique_ptr<format_table> formats_;
+			};
+
 			struct item_data
 			{
 				using container = std::vector<cell>;
 
-				std::unique_ptr<container> cells;
-				nana::color bgcolor;
-				nana::color fgcolor;
-				paint::image img;
-				nana::size img_show_size;
+				/// The attributes which are rarely set, they are allocated when one of them is set.
+				struct decoration
+				{
+					nana::color bgcolor;
+					nana::color fgcolor;
+					paint::image img;
+					nana::size img_show_size;
+					std::unique_ptr<nana::any> anyobj;
+
+					decoration() = default;
+
+					decoration(const decoration& r)
+						:	bgcolor(r.bgcolor),
+							fgcolor(r.fgcolor),
+							img(r.img),
+							img_show_size(r.img_show_size),
+							anyobj(r.anyobj ? new nana::any(*r.anyobj) : nullptr)
+					{}
+				};
+
+				cell_row cells;
+				std::unique_ptr<decoration> decoration_ptr;
 
 				struct inner_flags
 				{
@@ -618,138 +953,778 @@ namespace nana
 					bool checked	:1;
 				}flags;
 
-				mutable std::unique_ptr<nana::any> anyobj;
-
 				item_data() noexcept
 				{
 					flags.selected = flags.checked = false;
 				}
 
 				item_data(const item_data& r)
-					:	cells(r.cells ? std::make_unique<container>(*r.cells) : nullptr),
-						bgcolor(r.bgcolor),
-						fgcolor(r.fgcolor),
-						img(r.img),
-						flags(r.flags),
-						anyobj(r.anyobj ? new nana::any(*r.anyobj) : nullptr)
+					:	cells(r.cells),
+						decoration_ptr(r.decoration_ptr ? std::make_unique<decoration>(*r.decoration_ptr) : nullptr),
+						flags(r.flags)
 				{}
 
 				item_data(container&& cont)
-					: cells(std::make_unique<container>(std::move(cont)))
+					: cells(cont)
+				{
+					flags.selected = flags.checked = false;
+				}
+
+				item_data(std::string&& s)
 				{
 					flags.selected = flags.checked = false;
+
+					container cont;
+					cont.emplace_back(std::move(s));
+					cells.assign(cont);
 				}
 
-				item_data(std::string&& s)
-					: cells(std::make_unique<container>())
+				item_data& operator=(const item_data& r)
+				{
+					if (this != &r)
+					{
+						cells = r.cells;
+						decoration_ptr.reset(r.decoration_ptr ? new decoration(*r.decoration_ptr) : nullptr);
+						flags = r.flags;
+					}
+					return *this;
+				}
+
+				/// Returns the decoration, an item which is not decorated returns the default decoration.
+				const decoration& decor() const noexcept
+				{
+					static const decoration undecorated;
+					return (decoration_ptr ? *decoration_ptr : undecorated);
+				}
+
+				/// Returns the decoration for modification, it is allocated if the item is not decorated.
+				decoration& decorate()
+				{
+					if (!decoration_ptr)
+						decoration_ptr.reset(new decoration);
+					return *decoration_ptr;
+				}
+
+				std::string to_string(const export_options& exp_opt, const std::vector<cell>* model_cells) const
+				{
+					std::string item_str;
+
+					bool ignore_first = true;
+
+					for (auto col : exp_opt.columns_order)
+					{
+						if (ignore_first)
+							ignore_first = false;
+						else
+							item_str += exp_opt.sep;
+
+						//Use the model cells instead if model cells is available
+						item_str += (model_cells ? (*model_cells)[col].text : cells.text(col));
+					}
+
+                    return item_str;
+				}
+			};
+
+			/// A set of rows which is stored by ranges, a range of selected rows costs a node regardless of its length.
+			class row_set
+			{
+			public:
+				bool contains(std::size_t pos) const
+				{
+					auto i = ranges_.upper_bound(pos);
+					return ((i != ranges_.begin()) && (pos < (--i)->second));
+				}
+
+				void set(std::size_t pos, bool value)
+				{
+					if (value)
+						insert(pos, pos + 1);
+					else
+						erase(pos, pos + 1);
+				}
+
+				/// Inserts the rows in [first, last)
+				void insert(std::size_t first, std::size_t last)
+				{
+					if (first >= last)
+						return;
+
+					//Merges the overlapped and adjacent ranges
+					auto i = ranges_.upper_bound(first);
+					if (i != ranges_.begin())
+					{
+						auto prev = std::prev(i);
+						if (prev->second >= first)
+						{
+							first = prev->first;
+							last = (std::max)(last, prev->second);
+							ranges_.erase(prev);
+						}
+					}
+
+					while ((i != ranges_.end()) && (i->first <= last))
+					{
+						last = (std::max)(last, i->second);
+						i = ranges_.erase(i);
+					}
+
+					ranges_.emplace_hint(i, first, last);
+				}
+
+				/// Erases the rows in [first, last)
+				void erase(std::size_t first, std::size_t last)
+				{
+					if (first >= last)
+						return;
+
+					auto i = ranges_.upper_bound(first);
+					if (i != ranges_.begin())
+					{
+						auto prev = std::prev(i);
+						if (prev->second > first)
+						{
+							auto const end = prev->second;
+							if (prev->first == first)
+								ranges_.erase(prev);
+							else
+								prev->second = first;
+
+							if (end > last)
+							{
+								ranges_.emplace_hint(i, last, end);
+								return;
+							}
+						}
+					}
+
+					while ((i != ranges_.end()) && (i->first < last))
+					{
+						if (i->second > last)
+						{
+							auto const end = i->second;
+							i = ranges_.erase(i);
+							ranges_.emplace_hint(i, last, end);
+							return;
+						}
+						i = ranges_.erase(i);
+					}
+				}
+
+				void clear() noexcept
+				{
+					ranges_.clear();
+				}
+
+				bool operator==(const row_set& other) const
+				{
+					return (ranges_ == other.ranges_);
+				}
+
+				/// Returns true if the set contains all rows in [0, size)
+				bool contains_all(std::size_t size) const
+				{
+					return (size == 0) || ((!ranges_.empty()) && (ranges_.begin()->first == 0) && (ranges_.begin()->second >= size));
+				}
+
+				/// Calls the function for each row in ascending order, the set shall not be modified by the function.
+				template<typename Function>
+				void for_each(Function fn) const
+				{
+					for (auto & r : ranges_)
+					{
+						for (auto pos = r.first; pos < r.second; ++pos)
+							fn(pos);
+					}
+				}
+			private:
+				std::map<std::size_t, std::size_t> ranges_;	///< The first row to the end of a range
+			};
+
+			/// Counts the texts of the measured columns of a category by their widths in pixels.
+			/**
+			 * A column is measured when its content width is requested for the first time, and then the counts are updated
+			 * when the items are inserted, modified and erased, so that the widest text is known without measuring all items.
+			 * The counts are discarded when they can't be updated, and the column is measured again when it's requested.
+			 */
+			class column_extents
+			{
+			public:
+				bool measured(std::size_t col) const
+				{
+					return (columns_.count(col) != 0);
+				}
+
+				bool empty() const noexcept
+				{
+					return columns_.empty();
+				}
+
+				/// Marks a column as measured, the widths of its texts are added later.
+				void measure(std::size_t col)
+				{
+					columns_[col];
+				}
+
+				void add(std::size_t col, unsigned pixels)
+				{
+					++columns_[col][pixels];
+				}
+
+				/// Adds or removes the widths of the texts of an item for the measured columns
+				/**
+				 * @param cells The number of cells of the item
+				 * @param add Indicates whether to add or remove the widths
+				 * @param measure A function returns the width of the text of a cell in pixels
+				 */
+				template<typename Measure>
+				void count(std::size_t cells, bool add, Measure measure)
+				{
+					for (auto & m : columns_)
+					{
+						if (m.first >= cells)
+							continue;
+
+						auto const pixels = measure(m.first);
+						if (add)
+						{
+							++m.second[pixels];
+							continue;
+						}
+
+						auto i = m.second.find(pixels);
+						if ((i != m.second.end()) && (0 == --i->second))
+							m.second.erase(i);
+					}
+				}
+
+				/// Returns the width of the widest text of a measured column
+				unsigned max_pixels(std::size_t col) const
+				{
+					auto i = columns_.find(col);
+					if ((i == columns_.end()) || i->second.empty())
+						return 0;
+
+					return i->second.crbegin()->first;
+				}
+
+				void clear() noexcept
+				{
+					columns_.clear();
+				}
+
+				/// Removes the widths of all texts, it's called when all items are removed and the columns are still measured.
+				void reset() noexcept
+				{
+					for (auto & m : columns_)
+						m.second.clear();
+				}
+			private:
+				std::map<std::size_t, std::map<unsigned, std::size_t>> columns_;	///< The numbers of the texts by their widths, for each column
+			};
+
+			class inline_indicator;
+
+			struct category_t
+			{
+				using container = std::deque<item_data>;
+
+				/// The rows of a virtual category. The cells of a row are fetched from the model when they are needed,
+				/// and only the rows which have states are stored.
+				struct virtual_rows
+				{
+					std::size_t size{ 0 };
+					row_set selected;
+					row_set checked;
+					std::map<std::size_t, item_data> decorated;	///< The rows which have colors, an icon or a value
+				};
+
+				/// The filter of a category, only the items which match it are displayed.
+				struct filter_state
+				{
+					std::function<bool(const item_proxy&)> predicate;	///< The items are matched by the query if it's empty
+					std::size_t column{ npos };
+					std::string query;				///< It's folded to lowercase if it isn't case-sensitive
+					bool case_sensitive{ false };
+
+					std::vector<char> matched;			///< Indicates whether an item matches the filter, by absolute position
+					std::vector<std::size_t> shown;		///< The absolute positions of the displayed items in display order
+				};
+
+				native_string_type text;
+
+				/// The absolute positions in display order. It's empty for a virtual category which is never sorted.
+				std::vector<std::size_t> sorted;
+				container items;
+
+				std::unique_ptr<model_interface> model_ptr;
+				std::unique_ptr<virtual_rows> virtual_ptr;
+				std::unique_ptr<filter_state> filter_ptr;
+				std::shared_ptr<model_feed> feed_ptr;	///< The operations which are fed to the model by other threads
+
+				column_extents extents;	///< The widths of the texts of the measured columns
+
+				bool expand{ true };
+				bool display_number{ true };
+
+				//A cat may have a key object to identify the category
+				std::shared_ptr<nana::detail::key_interface> key_ptr;
+
+				std::deque<pat::cloneable<pat::abstract_factory<inline_notifier_interface>>> factories;
+				std::deque<std::unique_ptr<inline_indicator>> indicators;
+
+				category_t(native_string_type str = {}) noexcept
+					:text(std::move(str))
+				{}
+
+				bool selected() const noexcept
+				{
+					return (size() != 0) && all_flagged(true);
+				}
+
+				/// Returns the number of items
+				std::size_t size() const noexcept
+				{
+					return (virtual_ptr ? virtual_ptr->size : items.size());
+				}
+
+				/// Returns the number of displayed items, the items which don't match the filter are not displayed.
+				std::size_t displayed() const noexcept
+				{
+					return (filter_ptr ? filter_ptr->shown.size() : size());
+				}
+
+				/// Converts a display position to the absolute position
+				std::size_t absolute(std::size_t display_pos) const
+				{
+					if (filter_ptr)
+						return filter_ptr->shown[display_pos];
+
+					if (sorted.empty() && virtual_ptr)
+						return display_pos;
+
+					return sorted[display_pos];
+				}
+
+				const item_data& item(std::size_t pos) const
+				{
+					if (virtual_ptr)
+					{
+						static const item_data undecorated;
+
+						check_range(pos, virtual_ptr->size);
+						auto i = virtual_ptr->decorated.find(pos);
+						return (i != virtual_ptr->decorated.end() ? i->second : undecorated);
+					}
+					return items.at(pos);
+				}
+
+				/// Returns the item for modification, a row of virtual category is stored from now on.
+				item_data& mutable_item(std::size_t pos)
+				{
+					if (virtual_ptr)
+					{
+						check_range(pos, virtual_ptr->size);
+						return virtual_ptr->decorated[pos];
+					}
+					return items.at(pos);
+				}
+
+				/// Returns the selected or checked state of an item
+				bool flag(std::size_t pos, bool for_selection) const
+				{
+					if (virtual_ptr)
+					{
+						check_range(pos, virtual_ptr->size);
+						return (for_selection ? virtual_ptr->selected : virtual_ptr->checked).contains(pos);
+					}
+
+					auto & flags = items.at(pos).flags;
+					return (for_selection ? flags.selected : flags.checked);
+				}
+
+				/// Sets the selected or checked state of an item, returns true if the state is changed
+				bool flag(std::size_t pos, bool for_selection, bool value)
+				{
+					if (flag(pos, for_selection) == value)
+						return false;
+
+					if (virtual_ptr)
+						(for_selection ? virtual_ptr->selected : virtual_ptr->checked).set(pos, value);
+					else if (for_selection)
+						items[pos].flags.selected = value;
+					else
+						items[pos].flags.checked = value;
+					return true;
+				}
+
+				/// Calls the function for each selected or checked item in ascending order, the states shall not be modified by the function.
+				template<typename Function>
+				void for_each_flagged(bool for_selection, Function fn) const
+				{
+					if (virtual_ptr)
+					{
+						(for_selection ? virtual_ptr->selected : virtual_ptr->checked).for_each(fn);
+						return;
+					}
+
+					std::size_t pos = 0;
+					for (auto & m : items)
+					{
+						if (for_selection ? m.flags.selected : m.flags.checked)
+							fn(pos);
+						++pos;
+					}
+				}
+
+				/// Returns the positions of the selected or checked items
+				std::vector<std::size_t> flagged(bool for_selection) const
+				{
+					std::vector<std::size_t> positions;
+					for_each_flagged(for_selection, [&positions](std::size_t pos){
+						positions.push_back(pos);
+					});
+					return positions;
+				}
+
+				/// Returns true if all items are selected or checked
+				bool all_flagged(bool for_selection) const
+				{
+					if (virtual_ptr)
+						return (for_selection ? virtual_ptr->selected : virtual_ptr->checked).contains_all(virtual_ptr->size);
+
+					for (auto & m : items)
+					{
+						if (false == (for_selection ? m.flags.selected : m.flags.checked))
+							return false;
+					}
+					return true;
+				}
+
+				void make_sort_order()
+				{
+					sorted.clear();
+					sorted.reserve(size());
+					for (std::size_t i = 0; i < size(); ++i)
+						sorted.push_back(i);
+				}
+
+				/// Makes the display order of the matched items by the sort order
+				void make_filtered_order()
+				{
+					if (!filter_ptr)
+						return;
+
+					auto & flt = *filter_ptr;
+					auto const identity = (sorted.empty() && virtual_ptr);
+
+					flt.shown.clear();
+					for (std::size_t i = 0, count = (identity ? size() : sorted.size()); i < count; ++i)
+					{
+						auto const pos = (identity ? i : sorted[i]);
+						if ((pos < flt.matched.size()) && flt.matched[pos])
+							flt.shown.push_back(pos);
+					}
+				}
+				
+				std::vector<cell> cells(size_type pos) const
+				{
+					if (model_ptr)
+						return model_ptr->container()->to_cells(pos);
+
+					return items.at(pos).cells.to_cells();
+				}
+
+				/// Returns the text of a cell, it throws std::out_of_range if the cell doesn't exist.
+				std::string cell_text(size_type pos, size_type col) const
+				{
+					if (model_ptr)
+						return model_ptr->container()->to_cells(pos).at(col).text;
+
+					auto & cells = items.at(pos).cells;
+					if (col >= cells.size())
+						throw std::out_of_range("listbox: invalid column");
+
+					return cells.text(col);
+				}
+			};
+
+			struct inline_pane
+			{
+				::nana::panel<false> pane_bottom;	//pane for pane_widget
+				::nana::panel<false> pane_widget;	//pane for placing user-define widget
+				std::unique_ptr<inline_notifier_interface> inline_ptr;
+				inline_indicator * indicator;
+				index_pair	item_pos;				//The item index of the inline widget
+				std::size_t	column_pos;
+			};
+
+			enum class view_action
+			{
+				auto_view,
+				top_view,
+				bottom_view,
+			};
+
+			/// Returns the number of chunks for processing a sequence in parallel, a small sequence is processed in the calling thread.
+			inline std::size_t parallel_chunks(std::size_t size) noexcept
+			{
+#ifndef STD_THREAD_NOT_SUPPORTED
+				//The sequence which is smaller than this is processed in the calling thread.
+				constexpr std::size_t parallel_threshold = 64 * 1024;
+
+				if (size >= parallel_threshold)
+					return (std::max)((std::min)(std::thread::hardware_concurrency(), 8u), 1u);
+#endif
+				return 1;
+			}
+
+			/// Calls the function for each chunk [first, last) of [0, size), the chunks except the first one are processed in worker threads.
+			/**
+			 * The function shall not access the data of other chunks. If the function throws, the exception is rethrown
+			 * in the calling thread after all the chunks are processed.
+			 */
+			template<typename Function>
+			void for_each_chunk(std::size_t size, std::size_t chunks, Function fn)
+			{
+				auto const length = (size + chunks - 1) / chunks;
+				if (0 == length)
+					return;
+
+#ifndef STD_THREAD_NOT_SUPPORTED
+				//An exception shall not escape from a worker thread, it is kept for each chunk.
+				std::vector<std::exception_ptr> errors((size + length - 1) / length);
+				auto run = [&fn, &errors, length](std::size_t first, std::size_t last){
+					try
+					{
+						fn(first, last);
+					}
+					catch (...)
+					{
+						errors[first / length] = std::current_exception();
+					}
+				};
+
+				std::vector<std::thread> workers;
+				workers.reserve(errors.size() - 1);
+				for (auto first = length; first < size; first += length)
+				{
+					auto const last = (std::min)(first + length, size);
+					try
+					{
+						workers.emplace_back([first, last, &run]{
+							run(first, last);
+						});
+					}
+					catch (std::system_error&)
+					{
+						//Processes the chunk in the calling thread if a thread can't be started.
+						run(first, last);
+					}
+				}
+
+				run(0, length);
+				for (auto & thr : workers)
+					thr.join();
+
+				for (auto & err : errors)
+				{
+					if (err)
+						std::rethrow_exception(err);
+				}
+#else
+				for (std::size_t first = 0; first < size; first += length)
+					fn(first, (std::min)(first + length, size));
+#endif
+			}
+
+			/// Sorts the absolute positions stably, a large sequence is sorted by chunks in worker threads and then the chunks are merged.
+			template<typename Compare>
+			void parallel_stable_sort(std::vector<std::size_t>& seq, Compare comp)
+			{
+				auto const size = seq.size();
+				auto const chunks = parallel_chunks(size);
+				if (chunks < 2)
+				{
+					std::stable_sort(seq.begin(), seq.end(), comp);
+					return;
+				}
+
+				auto const begin = seq.begin();
+				for_each_chunk(size, chunks, [begin, &comp](std::size_t first, std::size_t last){
+					std::stable_sort(begin + first, begin + last, comp);
+				});
+
+				auto const length = (size + chunks - 1) / chunks;
+				for (auto width = length; width < size; width *= 2)
+				{
+					for (std::size_t first = 0; first + width < size; first += 2 * width)
+						std::inplace_merge(begin + first, begin + first + width, begin + (std::min)(first + 2 * width, size), comp);
+				}
+			}
+
+			inline char fold_char(char c) noexcept
+			{
+				return (('A' <= c) && (c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c);
+			}
+
+			/// Folds the ASCII letters of a text to lowercase, the other UTF-8 characters are kept.
+			inline void fold_text(std::string& text) noexcept
+			{
+				for (auto & c : text)
+					c = fold_char(c);
+			}
+
+			/// Returns true if the text contains the query, a query which isn't case-sensitive shall be folded.
+			inline bool contains_text(const char* text, std::size_t length, const std::string& query, bool case_sensitive) noexcept
+			{
+				auto const end = text + length;
+				if (case_sensitive)
+					return (std::search(text, end, query.begin(), query.end()) != end);
+
+				return (std::search(text, end, query.begin(), query.end(), [](char a, char b){
+					return (fold_char(a) == b);
+				}) != end);
+			}
+
+			inline bool contains_text(const std::string& text, const std::string& query, bool case_sensitive) noexcept
+			{
+				return contains_text(text.data(), text.size(), query, case_sensitive);
+			}
+
+			/// Indexes the categories by position, and counts their lines by a Fenwick tree.
+			/**
+			 * A category takes a line for its title and a line for each displayed item if it is expanded. The title line of
+			 * the first category is not displayed, but it is counted for keeping the lines of all categories uniform.
+			 * The index is rebuilt lazily after the categories are inserted or removed, and the lines of a category
+			 * are updated in O(log n) after its items are inserted, removed, expanded or collapsed.
+			 */
+			class category_index
+			{
+			public:
+				using container = std::list<category_t>;
+
+				category_index(container& cont) noexcept
+					: cont_(cont)
 				{
-					flags.selected = flags.checked = false;
-					cells->emplace_back(std::move(s));
 				}
 
-				item_data& operator=(const item_data& r)
+				/// Marks the index to be rebuilt, it's called after the categories are inserted or removed.
+				void invalidate() noexcept
 				{
-					if (this != &r)
-					{
-						if (r.cells)
-							cells = std::make_unique<container>(*r.cells);
-
-						flags = r.flags;
-						anyobj.reset(r.anyobj ? new nana::any(*r.anyobj) : nullptr);
-						bgcolor = r.bgcolor;
-						fgcolor = r.fgcolor;
-						img = r.img;
-					}
-					return *this;
+					dirty_ = true;
 				}
 
-				std::string to_string(const export_options& exp_opt, const std::vector<cell>* model_cells) const
+				/// Updates the lines of a category.
+				void update(std::size_t pos)
 				{
-					std::string item_str;
-
-					bool ignore_first = true;
+					if (dirty_ || (pos >= cats_.size()))
+						return;
 
-					for (auto col : exp_opt.columns_order)
+					auto const lines = lines_of(*cats_[pos]);
+					if (lines != lines_[pos])
 					{
-						if (ignore_first)
-							ignore_first = false;
-						else
-							item_str += exp_opt.sep;
+						//The unsigned arithmetic wraps around when the lines decrease.
+						auto const delta = lines - lines_[pos];
+						lines_[pos] = lines;
 
-						//Use the model cells instead if model cells is available
-						item_str += (model_cells ? model_cells : cells.get())->operator[](col).text;
+						for (auto i = pos + 1; i < tree_.size(); i += (i & (~i + 1)))
+							tree_[i] += delta;
 					}
-
-                    return item_str;
 				}
-			};
 
-			class inline_indicator;
+				container::iterator at(std::size_t pos)
+				{
+					_m_build();
+					return cats_[pos];
+				}
 
-			struct category_t
-			{
-				using container = std::deque<item_data>;
+				/// Returns the position of a category, or npos if the category is not found.
+				std::size_t position(const category_t* cat)
+				{
+					_m_build();
+					auto i = positions_.find(cat);
+					return (i != positions_.end() ? i->second : npos);
+				}
 
-				native_string_type text;
-				std::vector<std::size_t> sorted;
-				container items;
+				/// Returns the number of lines of the categories before the category specified by pos.
+				std::size_t lines_before(std::size_t pos)
+				{
+					_m_build();
 
-				std::unique_ptr<model_interface> model_ptr;
+					std::size_t lines = 0;
+					for (auto i = (std::min)(pos, cats_.size()); i; i -= (i & (~i + 1)))
+						lines += tree_[i];
+					return lines;
+				}
 
-				bool expand{ true };
-				bool display_number{ true };
+				/// Returns the number of lines of all categories
+				std::size_t lines()
+				{
+					return lines_before(npos);
+				}
 
-				//A cat may have a key object to identify the category
-				std::shared_ptr<nana::detail::key_interface> key_ptr;
+				/// Finds the category which contains the line, the line must be less than lines().
+				std::size_t find(std::size_t line)
+				{
+					_m_build();
 
-				std::deque<pat::cloneable<pat::abstract_factory<inline_notifier_interface>>> factories;
-				std::deque<std::unique_ptr<inline_indicator>> indicators;
+					std::size_t pos = 0;
 
-				category_t(native_string_type str = {}) noexcept
-					:text(std::move(str))
-				{}
+					std::size_t step = 1;
+					while ((step << 1) <= cats_.size())
+						step <<= 1;
 
-				bool selected() const noexcept
-				{
-					for (auto & m : items)
+					for (; step; step >>= 1)
 					{
-						if (false == m.flags.selected)
-							return false;
+						if ((pos + step <= cats_.size()) && (tree_[pos + step] <= line))
+						{
+							pos += step;
+							line -= tree_[pos];
+						}
 					}
-					return !items.empty();
+					return pos;
 				}
-
-				void make_sort_order()
+			private:
+				static std::size_t lines_of(const category_t& cat) noexcept
 				{
-					sorted.clear();
-					for (std::size_t i = 0; i < items.size(); ++i)
-						sorted.push_back(i);
+					return 1 + (cat.expand ? cat.displayed() : 0);
 				}
-				
-				std::vector<cell> cells(size_type pos) const
+
+				void _m_build()
 				{
-					if (model_ptr)
-						return model_ptr->container()->to_cells(pos);
+					if (!dirty_)
+						return;
 
-					return *(items.at(pos).cells);
-				}
-			};
+					cats_.clear();
+					lines_.clear();
+					positions_.clear();
 
-			struct inline_pane
-			{
-				::nana::panel<false> pane_bottom;	//pane for pane_widget
-				::nana::panel<false> pane_widget;	//pane for placing user-define widget
-				std::unique_ptr<inline_notifier_interface> inline_ptr;
-				inline_indicator * indicator;
-				index_pair	item_pos;				//The item index of the inline widget
-				std::size_t	column_pos;
-			};
+					//Builds the tree in O(n), each node adds its sum to its parent.
+					tree_.assign(cont_.size() + 1, 0);
+					for (auto i = cont_.begin(); i != cont_.end(); ++i)
+					{
+						positions_[&(*i)] = cats_.size();
+						cats_.push_back(i);
+						lines_.push_back(lines_of(*i));
 
-			enum class view_action
-			{
-				auto_view,
-				top_view,
-				bottom_view,
+						auto const node = cats_.size();
+						tree_[node] += lines_.back();
+
+						auto const parent = node + (node & (~node + 1));
+						if (parent < tree_.size())
+							tree_[parent] += tree_[node];
+					}
+
+					dirty_ = false;
+				}
+			private:
+				container& cont_;
+				bool dirty_{ true };
+				std::vector<container::iterator> cats_;
+				std::vector<std::size_t> lines_;
+				std::vector<std::size_t> tree_;		///< The Fenwick tree of lines, 1-based.
+				std::map<const category_t*, std::size_t> positions_;
 			};
 
 			class es_lister
@@ -792,17 +1767,19 @@ namespace nana
 				nana::any * anyobj(const index_pair& id, bool allocate_if_empty) const
 				{
 					auto& catobj = *get(id.cat);
-					if(id.item < catobj.items.size())
+					if(id.item < catobj.size())
 					{
-						auto& item = catobj.items[id.item];
+						auto& decor = catobj.item(id.item).decor();
 
-						if(item.anyobj)
-							return item.anyobj.get();
+						if(decor.anyobj)
+							return decor.anyobj.get();
 
 						if (allocate_if_empty)
 						{
-							item.anyobj.reset(new ::nana::any);
-							return item.anyobj.get();
+							//The const_cast is safe, the category is not a const object.
+							auto & m = const_cast<category_t&>(catobj).mutable_item(id.item).decorate();
+							m.anyobj.reset(new ::nana::any);
+							return m.anyobj.get();
 						}
 					}
 					return nullptr;
@@ -835,8 +1812,27 @@ namespace nana
 					}
 				}
 
-				// Definition is provided after struct essence
-				unsigned column_content_pixels(size_type pos) const;
+				/// Returns the width of the widest text of a column
+				/**
+				 * The column of a category is measured for the first time, and then the widths of its texts are counted as the items
+				 * are modified, so that the width is returned without measuring all items again.
+				 * Definition is provided after struct essence
+				 */
+				unsigned column_content_pixels(size_type pos);
+
+				/// Adds or removes the widths of the texts of an item for the measured columns of its category.
+				/**
+				 * It's called with add false before the texts of an item are modified or the item is erased, and with add true after
+				 * the item is inserted or its texts are modified. Definition is provided after struct essence
+				 */
+				void measure_item(category_t& cat, std::size_t pos, bool add);
+
+				/// Discards the widths of the texts of all categories, the columns are measured again when they are requested.
+				void invalidate_extents() noexcept
+				{
+					for (auto & cat : categories_)
+						cat.extents.clear();
+				}
 
 				const sort_attributes& sort_attrs() const noexcept
 				{
@@ -846,117 +1842,167 @@ namespace nana
                 /// each sort() invalidates any existing reference from display position to absolute item, that is after sort() display offset point to different items
                 void sort()
 				{
-					if((npos == sort_attrs_.column) || (!sort_attrs_.resort))
+					if (!_m_sorting())
 						return;
 
-					auto weak_ordering_comp = fetch_ordering_comparer(sort_attrs_.column);
-					if(weak_ordering_comp)
+					for (auto & cat : categories_)
 					{
-						for (auto & cat : categories_)
-						{
-							const bool use_model = (cat.model_ptr != nullptr);
-
-							std::stable_sort(cat.sorted.begin(), cat.sorted.end(), [&cat, &weak_ordering_comp, use_model, this](std::size_t x, std::size_t y){
-								//The predicate must be a strict weak ordering.
-								//!comp(x, y) != comp(x, y)
-								if (use_model)
-								{
-									auto & mx = cat.items[x];
-									auto & my = cat.items[y];
+						_m_sort(cat);
+						_m_filtered(cat);
+					}
+				}
 
-									auto mx_cells = cat.model_ptr->container()->to_cells(x);
-									auto my_cells = cat.model_ptr->container()->to_cells(y);
+				/// Places the items which are appended to a category in the display order, and measures their texts.
+				/**
+				 * The items from the absolute position first to the end of the category are not in the sort order yet. They
+				 * are merged into the sort order if the category is being sorted, otherwise they are displayed at the end.
+				 */
+				void place_items(category_t& cat, std::size_t first)
+				{
+					if (first >= cat.size())
+						return;
 
-									if (mx_cells.size() <= sort_attrs_.column || my_cells.size() <= sort_attrs_.column)
-									{
-										std::string a;
-										if (mx_cells.size() > sort_attrs_.column)
-											a = mx_cells[sort_attrs_.column].text;
+					for (auto i = first; i < cat.size(); ++i)
+						measure_item(cat, i, true);
 
-										std::string b;
-										if (my_cells.size() > sort_attrs_.column)
-											b = my_cells[sort_attrs_.column].text;
+					//The sort order is made again if it doesn't match the items.
+					if ((first == 0) || (cat.sorted.size() != first))
+					{
+						cat.make_sort_order();
+						if (_m_sorting())
+							_m_sort(cat);
+					}
+					else
+					{
+						std::vector<std::size_t> positions;
+						positions.reserve(cat.size() - first);
+						for (auto i = first; i < cat.size(); ++i)
+							positions.push_back(i);
 
-										return weak_ordering_comp(a, mx.anyobj.get(), b, my.anyobj.get(), sort_attrs_.reverse);
-									}
+						_m_merge_order(cat, positions);
+					}
 
-									return weak_ordering_comp(mx_cells[sort_attrs_.column].text, mx.anyobj.get(), my_cells[sort_attrs_.column].text, my.anyobj.get(), sort_attrs_.reverse);
-								}
-								
-								auto & mx = cat.items[x];
-								auto & my = cat.items[y];
+					refilter(cat, first);
+				}
 
-								if (mx.cells->size() <= sort_attrs_.column || my.cells->size() <= sort_attrs_.column)
-								{
-									std::string a;
-									if (mx.cells->size() > sort_attrs_.column)
-										a = (*mx.cells)[sort_attrs_.column].text;
+				/// Applies the operations which are fed to the model of a category.
+				/**
+				 * The operations which are queued when it's called are applied one at a time while the model is locked, the operations
+				 * which are queued meanwhile are left for the next call. An operation at an invalid position is ignored, except that
+				 * an insertion beyond the end appends the item. If an operation throws, it is discarded and the items are made again
+				 * from the container.
+				 * @param updated Receives the display positions of the updated items which are displayed in place.
+				 * @return true if the items are inserted, erased or moved in display order.
+				 */
+				bool apply_feed(category_t& cat, std::vector<index_pair>& updated)
+				{
+					auto & feed = *cat.feed_ptr;
+					auto count = feed.pending();
+					if (0 == count)
+						return false;
 
-									std::string b;
-									if (my.cells->size() > sort_attrs_.column)
-										b = (*my.cells)[sort_attrs_.column].text;
+					auto const cat_pos = index_.position(&cat);
+					bool rearranged = false;
 
-									return weak_ordering_comp(a, mx.anyobj.get(), b, my.anyobj.get(), sort_attrs_.reverse);
-								}
+					model_guard guard{ cat.model_ptr.get() };
 
-								return weak_ordering_comp((*mx.cells)[sort_attrs_.column].text, mx.anyobj.get(), (*my.cells)[sort_attrs_.column].text, my.anyobj.get(), sort_attrs_.reverse);
-							});
+					model_feed::operation op;
+					for (; count && feed.pop(op); --count)
+					{
+						try
+						{
+							if (_m_apply(cat, cat_pos, guard, op, updated))
+								rearranged = true;
+						}
+						catch (...)
+						{
+							_m_resync(cat, cat_pos);
+							rearranged = true;
 						}
 					}
+					return rearranged;
+				}
+
+				/// Displays the items of a category whose texts of a column contain the query, an empty query removes the filter.
+				/**
+				 * If the query extends the previous query of the same column, only the items which match the previous query are tested.
+				 * The items of a large category without model are tested in worker threads.
+				 */
+				void filter(category_t& cat, size_type column, std::string query, bool case_sensitive)
+				{
+					if (query.empty())
+					{
+						unfilter(cat);
+						return;
+					}
+
+					if (!case_sensitive)
+						fold_text(query);
+
+					std::unique_ptr<category_t::filter_state> flt{ new category_t::filter_state };
+					flt->column = column;
+					flt->query = std::move(query);
+					flt->case_sensitive = case_sensitive;
+
+					//The items which match the extended query are a subset of the items which match the previous query.
+					auto prev = cat.filter_ptr.get();
+					if (prev && !prev->predicate && (prev->column == column) && (prev->case_sensitive == case_sensitive) &&
+						(flt->query.find(prev->query) != flt->query.npos) && (prev->matched.size() == cat.size()))
+						flt->matched = prev->matched;
 					else
-					{	//No user-defined comparer is provided, and default comparer is applying.
-						for (auto & cat : categories_)
-						{
-							const bool use_model = (cat.model_ptr != nullptr);
+						flt->matched.assign(cat.size(), 1);
 
-							std::stable_sort(cat.sorted.begin(), cat.sorted.end(), [this, &cat, use_model](std::size_t x, std::size_t y){
-								//The predicate must be a strict weak ordering.
-								//!comp(x, y) != comp(x, y)
-								if (use_model)
-								{
-									auto mx_cells = cat.model_ptr->container()->to_cells(x);
-									auto my_cells = cat.model_ptr->container()->to_cells(y);
+					_m_match_items(cat, *flt, 0, cat.size());
 
-									if (mx_cells.size() <= sort_attrs_.column || my_cells.size() <= sort_attrs_.column)
-									{
-										std::string a;
-										if (mx_cells.size() > sort_attrs_.column)
-											a = mx_cells[sort_attrs_.column].text;
+					cat.filter_ptr = std::move(flt);
+					_m_filtered(cat);
+				}
 
-										std::string b;
-										if (my_cells.size() > sort_attrs_.column)
-											b = my_cells[sort_attrs_.column].text;
+				/// Displays the items of a category which the predicate returns true for, an empty predicate removes the filter.
+				void filter(category_t& cat, std::function<bool(const item_proxy&)> pred)
+				{
+					if (!pred)
+					{
+						unfilter(cat);
+						return;
+					}
 
-										return (sort_attrs_.reverse ? a > b : a < b);
-									}
+					std::unique_ptr<category_t::filter_state> flt{ new category_t::filter_state };
+					flt->predicate = std::move(pred);
+					flt->matched.assign(cat.size(), 1);
 
-									auto & a = mx_cells[sort_attrs_.column].text;
-									auto & b = my_cells[sort_attrs_.column].text;
-									return (sort_attrs_.reverse ? a > b : a < b);
-								}
+					_m_match_items(cat, *flt, 0, cat.size());
 
-								auto & mx = cat.items[x];
-								auto & my = cat.items[y];
+					cat.filter_ptr = std::move(flt);
+					_m_filtered(cat);
+				}
 
-								if (mx.cells->size() <= sort_attrs_.column || my.cells->size() <= sort_attrs_.column)
-								{
-									std::string a;
-									if (mx.cells->size() > sort_attrs_.column)
-										a = (*mx.cells)[sort_attrs_.column].text;
+				void unfilter(category_t& cat)
+				{
+					if (cat.filter_ptr)
+					{
+						cat.filter_ptr.reset();
+						index_.update(index_.position(&cat));
+					}
+				}
 
-									std::string b;
-									if (my.cells->size() > sort_attrs_.column)
-										b = (*my.cells)[sort_attrs_.column].text;
+				/// Tests the items in [first, last) of a filtered category again, it's called after the items are appended or modified.
+				void refilter(category_t& cat, std::size_t first = 0, std::size_t last = npos)
+				{
+					if (!cat.filter_ptr)
+						return;
 
-									return (sort_attrs_.reverse ? a > b : a < b);
-								}
+					auto & flt = *cat.filter_ptr;
+					flt.matched.resize(cat.size(), 1);
 
-								auto & a = (*mx.cells)[sort_attrs_.column].text;
-								auto & b = (*my.cells)[sort_attrs_.column].text;
-								return (sort_attrs_.reverse ? a > b : a < b);
-							});
-						}
+					last = (std::min)(last, cat.size());
+					if (first < last)
+					{
+						std::fill(flt.matched.begin() + first, flt.matched.begin() + last, 1);
+						_m_match_items(cat, flt, first, last);
 					}
+
+					_m_filtered(cat);
 				}
 
 				/// Sorts the specified column
@@ -1033,11 +2079,13 @@ namespace nana
 							{
 								auto & catobj = *categories_.emplace(i);
 								catobj.key_ptr = ptr;
+								index_.invalidate();
 								return &catobj;
 							}
 						}
 					}
 
+					index_.invalidate();
 #ifdef _nana_std_has_emplace_return_type
 					auto & last_cat = categories_.emplace_back();
 					last_cat.key_ptr = ptr;
@@ -1054,6 +2102,7 @@ namespace nana
 				{
 					if (::nana::npos == pos)
 					{
+						index_.invalidate();
 #ifdef _nana_std_has_emplace_return_type
 						return &categories_.emplace_back(std::move(text));
 #else
@@ -1062,7 +2111,9 @@ namespace nana
 #endif
 					}
 
-					return &(*categories_.emplace(this->get(pos), std::move(text)));
+					auto & catobj = *categories_.emplace(this->get(pos), std::move(text));
+					index_.invalidate();
+					return &catobj;
 				}
 
 				/// Insert  before item in absolute "pos" a new item with "text" in column 0, and place it in last display position of this cat
@@ -1070,15 +2121,15 @@ namespace nana
 				{
 					auto & catobj = *get(pos.cat);
 
-					const auto item_count = catobj.items.size();
+					const auto item_count = catobj.size();
 
 					check_range(pos.item, item_count);
 
-					catobj.sorted.push_back(item_count);
+					//Checks the model before the sort order is changed, a virtual category is immutable.
+					throw_if_immutable_model(catobj.model_ptr.get());
 
 					if (catobj.model_ptr)
 					{
-						throw_if_immutable_model(catobj.model_ptr.get());
 						auto container = catobj.model_ptr->container();
 						std::size_t item_index;
 						//
@@ -1099,11 +2150,12 @@ namespace nana
 						cells.emplace_back(std::move(text));
 						cells.resize(columns);
 						container->assign(item_index, cells);
-
-						return;
 					}
+					else
+						catobj.items.emplace(catobj.items.begin() + (pos.item < item_count ? pos.item : item_count), std::move(text));
 
-					catobj.items.emplace(catobj.items.begin() + (pos.item < item_count ? pos.item : item_count), std::move(text));
+					index_.update(pos.cat);
+					_m_inserted(catobj, (std::min)(pos.item, item_count));
 				}
 
 				/// Converts an index between display position and absolute real position.
@@ -1125,18 +2177,23 @@ namespace nana
 				{
 					if (from.cat < categories_.size())
 					{
-						auto i = categories_.cbegin();
-						std::advance(i, from.cat);
+						auto i = get(from.cat);
 
 						auto & cat = *i;
-						if (from.item < cat.sorted.size())
+						if (from.item < (from_display_order ? cat.displayed() : cat.size()))
 						{
+							//The sort order of a virtual category is identical to the absolute order until it is sorted.
+							if (cat.sorted.empty() && !cat.filter_ptr)
+								return from;
+
 							if (from_display_order)
-								return index_pair{ from.cat, static_cast<size_type>(cat.sorted[from.item]) };
+								return index_pair{ from.cat, static_cast<size_type>(cat.absolute(from.item)) };
 
-							for (size_type i = 0; i < cat.sorted.size(); ++i)
+							//An item which doesn't match the filter has no display position.
+							auto & order = (cat.filter_ptr ? cat.filter_ptr->shown : cat.sorted);
+							for (size_type i = 0; i < order.size(); ++i)
 							{
-								if (from.item == cat.sorted[i])
+								if (from.item == order[i])
 									return index_pair{ from.cat, i };
 							}
 						}
@@ -1157,8 +2214,7 @@ namespace nana
 				{
 					if (pos.cat < categories_.size())
 					{
-						auto i = categories_.cbegin();
-						std::advance(i, pos.cat);
+						auto i = get(pos.cat);
 
 						throw_if_immutable_model(i->model_ptr.get());
 					}
@@ -1168,12 +2224,15 @@ namespace nana
 				{
 					if (pos.cat < categories_.size())
 					{
-						auto i = categories_.cbegin();
-						std::advance(i, pos.cat);
+						auto i = get(pos.cat);
 						if (i->model_ptr)
 						{
 							throw_if_immutable_model(i->model_ptr.get());
+
+							measure_item(*i, pos.item, false);
 							i->model_ptr->container()->assign(pos.item, cells);
+							measure_item(*i, pos.item, true);
+							refilter(*i, pos.item, pos.item + 1);
 						}
 					}
 				}
@@ -1185,7 +2244,7 @@ namespace nana
 
 				category_t::container::value_type& at_abs(const index_pair& pos)
 				{
-					return get(pos.cat)->items.at(pos.item);
+					return get(pos.cat)->mutable_item(pos.item);
 				}
 
 				std::vector<cell> at_model_abs(const index_pair& pos) const
@@ -1202,12 +2261,18 @@ namespace nana
 				/// return a ref to the real item object at display position
 				category_t::container::value_type& at(const index_pair& pos)
 				{
-					return get(pos.cat)->items.at(index_cast(pos, true).item);
+					return get(pos.cat)->mutable_item(index_cast(pos, true).item);
 				}
 
 				const category_t::container::value_type& at(const index_pair& pos) const
 				{
-					return get(pos.cat)->items.at(index_cast(pos, true).item);
+					return get(pos.cat)->item(index_cast(pos, true).item);
+				}
+
+				/// Returns the selected or checked state of an item specified by absolute position
+				bool flag(const index_pair& abs_pos, bool for_selection) const
+				{
+					return get(abs_pos.cat)->flag(abs_pos.item, for_selection);
 				}
 
 				std::vector<cell> at_model(const index_pair& pos) const
@@ -1250,6 +2315,13 @@ namespace nana
 
 					catobj.items.clear();
 					catobj.sorted.clear();
+					catobj.extents.reset();
+					if (catobj.filter_ptr)
+					{
+						catobj.filter_ptr->matched.clear();
+						catobj.filter_ptr->shown.clear();
+					}
+					index_.update(cat);
 				}
 
                 // Clears all items in all cat, but not the container of cat self.
@@ -1277,58 +2349,19 @@ namespace nana
 					if (0 == n)
 						return pos;
 
-					dpos = pos;
+					//The line of the target, the title of a category is the line 0 in the category.
+					auto const line = index_.lines_before(pos.cat) + (npos == pos.item ? 0 : pos.item + 1);
+
 					if (0 < n)
 					{
 						//Forward
-						std::size_t index = (npos == pos.item ? 0 : pos.item + 1);
-
-						while (n)
-						{
-							std::size_t end = 1;
-							if (expand(dpos.cat))
-								end += size_item(dpos.cat);
-
-							if (n < static_cast<int>(end - index))
-								return index_pair{ dpos.cat, index + n - 1 };
-
-							++dpos.cat;
-							if (cat_size == dpos.cat)
-								return index_pair{ npos, npos };
-
-							n -= static_cast<int>(end - index);
-							index = 0;
-						}
-						return index_pair{ dpos.cat, npos };
+						if (line + n >= index_.lines())
+							return index_pair{ npos, npos };
 					}
-					
-					//Backward
-					n = -n;
-					dpos = pos;
-					if (good(dpos.cat))
-					{
-						auto count = static_cast<int>(dpos.is_category() ? 1 : pos.item + 2);
-						auto i = get(pos.cat);
-						while (true)
-						{
-							if (count > n)
-							{
-								count -= n;
-								dpos.item = (count == 1 ? npos : count - 2);
-								return dpos;
-							}
-
-							n -= count;
-
-							if (i == categories_.cbegin())
-								break;
+					else if (line < static_cast<std::size_t>(-n))	//Backward
+						return index_pair{ npos, npos };
 
-							--i;
-							--dpos.cat;
-							count = static_cast<int>(i->expand ? i->items.size() : 0) + 1;
-						}
-					}
-					return index_pair{npos, npos};
+					return _m_locate(line + n);
 				}
 
                 /// change to index arg
@@ -1346,14 +2379,9 @@ namespace nana
 					else if(to.cat < from.cat)
 						std::swap(from, to);
 
-					std::size_t count = 1;
-					for (auto i = get(from.cat); i != get(to.cat); ++i)
-					{
-						if (i->expand)
-							count += i->items.size() + 1;
-						else
-							++count;
-					}
+					check_range(to.cat, categories_.size());
+
+					std::size_t count = 1 + index_.lines_before(to.cat) - index_.lines_before(from.cat);
 
 					if (npos != to.item)
 						count += (1 + to.item);
@@ -1368,24 +2396,18 @@ namespace nana
 
 				void text(category_t* cat, size_type pos, size_type abs_col, cell&& cl, size_type columns)
 				{
-					if ((abs_col < columns) && (pos < cat->items.size()))
+					if ((abs_col < columns) && (pos < cat->size()))
 					{
-						std::vector<cell> model_cells;
-
 						model_lock_guard lock(cat->model_ptr.get());
 						if (cat->model_ptr)
-						{
 							throw_if_immutable_model(cat->model_ptr.get());
-							model_cells = cat->model_ptr->container()->to_cells(pos);
-						}
 
-						auto & cells = (cat->model_ptr ? model_cells : *(cat->items[pos].cells));
+						auto cells = cat->cells(pos);
+						measure_item(*cat, pos, false);
 
 						if (abs_col < cells.size())
 						{
 							cells[abs_col] = std::move(cl);
-							if (sort_attrs_.column == abs_col)
-								sort();
 						}
 						else
 						{	//If the index of specified sub item is over the number of sub items that item contained,
@@ -1395,30 +2417,33 @@ namespace nana
 						}
 
 						if (cat->model_ptr)
-							cat->model_ptr->container()->assign(pos, model_cells);
+							cat->model_ptr->container()->assign(pos, cells);
+						else
+							cat->items[pos].cells.assign(cells);
+
+						measure_item(*cat, pos, true);
+
+						if (sort_attrs_.column == abs_col)
+							_m_resort_item(*cat, pos);
+
+						refilter(*cat, pos, pos + 1);
 					}
 				}
 
 				void text(category_t* cat, size_type pos, size_type abs_col, std::string&& str, size_type columns)
 				{
-					if ((abs_col < columns) && (pos < cat->items.size()))
+					if ((abs_col < columns) && (pos < cat->size()))
 					{
-						std::vector<cell> model_cells;
-
 						model_lock_guard lock(cat->model_ptr.get());
 						if (cat->model_ptr)
-						{
 							throw_if_immutable_model(cat->model_ptr.get());
-							model_cells = cat->model_ptr->container()->to_cells(pos);
-						}
 
-						auto & cells = (cat->model_ptr ? model_cells : *(cat->items[pos].cells));
+						auto cells = cat->cells(pos);
+						measure_item(*cat, pos, false);
 
 						if (abs_col < cells.size())
 						{
 							cells[abs_col].text = std::move(str);
-							if (sort_attrs_.column == abs_col)
-								sort();
 						}
 						else
 						{	//If the index of specified sub item is over the number of sub items that item contained,
@@ -1428,7 +2453,16 @@ namespace nana
 						}
 
 						if (cat->model_ptr)
-							cat->model_ptr->container()->assign(pos, model_cells);
+							cat->model_ptr->container()->assign(pos, cells);
+						else
+							cat->items[pos].cells.assign(cells);
+
+						measure_item(*cat, pos, true);
+
+						if (sort_attrs_.column == abs_col)
+							_m_resort_item(*cat, pos);
+
+						refilter(*cat, pos, pos + 1);
 					}
 				}
 
@@ -1449,9 +2483,19 @@ namespace nana
 
 						i->items.clear();
 						i->sorted.clear();
+						i->extents.reset();
+						if (i->filter_ptr)
+						{
+							i->filter_ptr->matched.clear();
+							i->filter_ptr->shown.clear();
+						}
+						index_.update(0);
 					}
 					else
+					{
 						categories_.erase(i);
+						index_.invalidate();
+					}
 				}
 
 				void erase()
@@ -1469,6 +2513,7 @@ namespace nana
 #else
 						categories_.erase(++categories_.begin(), categories_.end());
 #endif
+						index_.invalidate();
 					}
 				}
 
@@ -1481,6 +2526,7 @@ namespace nana
 						if(expanded != exp)
 						{
 							expanded = exp;
+							index_.update(cat);
 							return true;
 						}
 					}
@@ -1538,13 +2584,8 @@ namespace nana
 
 				size_type the_number_of_expanded() const noexcept
 				{
-					size_type n = categories_.size() - 1;
-					for (auto & i : categories_)
-					{
-						if(i.expand)
-							n += i.items.size();
-					}
-					return n;
+					//The title of the first category is not displayed.
+					return index_.lines() - 1;
 				}
 
 				/// Finds a good item or category if an item specified by pos is invalid
@@ -1559,7 +2600,7 @@ namespace nana
 						if ((pos.npos == pos.item) && !ignore_category)
 							return pos;
 
-						auto cat_item_size = this->get(pos.cat)->items.size();
+						auto cat_item_size = this->get(pos.cat)->size();
 
 						if (pos.item < cat_item_size)
 							return pos;
@@ -1587,7 +2628,12 @@ namespace nana
 					}
 					
 
-					auto fr_dpl = (fr_abs.is_category() ? fr_abs : this->index_cast(fr_abs, false));	//Converts an absolute position to display position
+					auto fr_dpl = (fr_abs.is_category() ? fr_abs : this->index_cast_noexcept(fr_abs, false));	//Converts an absolute position to display position
+
+					//The item is not displayed because of the filter
+					if (fr_dpl.empty())
+						fr_dpl = to_dpl;
+
                     if (fr_dpl > to_dpl)
 						std::swap(fr_dpl, to_dpl);
 
@@ -1612,7 +2658,7 @@ namespace nana
 								auto size = size_item(fr_dpl.cat);
 								for (std::size_t i = 0; i < size; ++i)
 								{
-									index_pair abs_pos{ fr_dpl.cat, i };
+									auto abs_pos = index_cast(index_pair{ fr_dpl.cat, i }, true);	//convert display position to absolute position
 									item_proxy m{ ess_, abs_pos };
 									pairs.emplace_back(abs_pos, m.selected());
 
@@ -1640,8 +2686,8 @@ namespace nana
 						//Deselects the already selected which is out of range [begin, last] 
 						for (auto index : already_selected)
 						{
-							auto disp_order = this->index_cast(index, false);	//converts an absolute position to a display position
-							if (begin > disp_order || disp_order > last)
+							auto disp_order = this->index_cast_noexcept(index, false);	//converts an absolute position to a display position
+							if (disp_order.empty() || begin > disp_order || disp_order > last)
 								item_proxy{ ess_, index }.select(false);
 						}
 					}
@@ -1655,29 +2701,102 @@ namespace nana
 					index_pair pos;
 					for (auto & cat : categories_)
 					{
-						pos.item = 0;
-						for(auto & m : cat.items)
+						//The states of a virtual category are changed by ranges and notified once.
+						if (cat.virtual_ptr)
 						{
-							if (except_abs != pos)
+							if (_m_select_virtual(cat, pos.cat, sel, except_abs))
+								changed = true;
+
+							++pos.cat;
+							continue;
+						}
+
+						//Only the selected items are visited when deselecting.
+						//Only the displayed items are selected if the category is filtered.
+						auto const positions = (sel ? std::vector<std::size_t>{} : cat.flagged(true));
+						auto const count = (sel ? cat.displayed() : positions.size());
+
+						for (std::size_t u = 0; u < count; ++u)
+						{
+							pos.item = (sel ? (cat.filter_ptr ? cat.filter_ptr->shown[u] : u) : positions[u]);
+							if ((except_abs != pos) && cat.flag(pos.item, true, sel))
 							{
-								if (m.flags.selected != sel)
-								{
-									changed = true;
-									m.flags.selected = sel;
+								changed = true;
 
-									this->emit_cs(pos, true);
+								this->emit_cs(pos, true);
 
-									if (m.flags.selected)
-										latest_selected_abs = pos;
-									else if (latest_selected_abs == pos)
-										latest_selected_abs.set_both(npos);		//make empty
-								}
+								if (sel)
+									latest_selected_abs = pos;
+								else if (latest_selected_abs == pos)
+									latest_selected_abs.set_both(npos);		//make empty
 							}
-							++pos.item;
 						}
 						++pos.cat;
 					}
-					return changed;
+					return changed;
+				}
+
+				/// Selects or deselects all items of a virtual category, except the item specified by except_abs.
+				/**
+				 * The selected items are stored as ranges, the category is changed without visiting each item, and the change is
+				 * notified by a bulk_selected event rather than a selected event per item.
+				 * @return true if the selection is changed.
+				 */
+				bool _m_select_virtual(category_t& cat, std::size_t cat_pos, bool sel, const index_pair& except_abs)
+				{
+					auto & rows = cat.virtual_ptr->selected;
+					auto const size = cat.virtual_ptr->size;
+					auto const except = ((except_abs.cat == cat_pos) && (except_abs.item < size) ? except_abs.item : npos);
+					auto const except_selected = ((npos != except) && rows.contains(except));
+
+					auto const before = rows;
+					index_pair last{ cat_pos, npos };
+					if (sel)
+					{
+						if (cat.filter_ptr)
+						{
+							//Only the displayed items are selected if the category is filtered.
+							for (auto abs : cat.filter_ptr->shown)
+							{
+								rows.set(abs, true);
+								if (abs != except)
+									last.item = abs;
+							}
+						}
+						else if (size)
+						{
+							rows.insert(0, size);
+							last.item = (size - 1 != except ? size - 1 : (size > 1 ? size - 2 : npos));
+						}
+					}
+					else
+						rows.clear();
+
+					//The state of the excepted item is kept
+					if (npos != except)
+						rows.set(except, except_selected);
+
+					if (rows == before)
+						return false;
+
+					if (sel)
+					{
+						if (npos != last.item)
+							latest_selected_abs = last;
+					}
+					else if ((latest_selected_abs.cat == cat_pos) && (latest_selected_abs.item != except))
+						latest_selected_abs.set_both(npos);
+
+					arg_listbox_bulk arg{ cat_proxy{ ess_, cat_pos }, sel };
+					wd_ptr()->events().bulk_selected.emit(arg, wd_ptr()->handle());
+
+					//notify the inline panes of the category
+					for (auto p : active_panes_)
+					{
+						if (p && (p->item_pos.cat == cat_pos) && (p->item_pos.item != except))
+							p->inline_ptr->notify_status(inline_widget_status::selecting, sel && cat.flag(p->item_pos.item, true));
+					}
+					return true;
 				}
 
 				/// return absolute positions, no relative to display
@@ -1696,19 +2815,16 @@ namespace nana
 
 					for (auto & cat : categories_)
 					{
-						id.item = 0;
-						for (auto & m : cat.items)
+						for (auto pos : cat.flagged(for_selection))
 						{
-							if (for_selection ? m.flags.selected : m.flags.checked)
-							{
-								if (items_status && *items_status)
-									*items_status = (for_selection ? m.flags.checked : m.flags.selected);
+							id.item = pos;
 
-								results.push_back(id);  // absolute positions, no relative to display
-								if (find_first)
-									return results;
-							}
-							++id.item;
+							if (items_status && *items_status)
+								*items_status = cat.flag(pos, !for_selection);
+
+							results.push_back(id);  // absolute positions, no relative to display
+							if (find_first)
+								return results;
 						}
 						++id.cat;
 					}
@@ -1719,18 +2835,6 @@ namespace nana
                 /// we are moving in display, but the selection ocurre in abs position
                 void move_select(bool upwards=true, bool unselect_previous=true, bool into_view=false) noexcept;
 
-				struct pred_cancel
-				{
-					const bool for_selection;
-
-					pred_cancel(bool for_sel) noexcept : for_selection(for_sel) {}
-
-					bool operator()(category_t::container::value_type & m) const noexcept
-					{
-						return (for_selection ? m.flags.selected : m.flags.checked);
-					}
-				};
-
 				struct emit_cancel
 				{
 					es_lister* const self;
@@ -1738,13 +2842,9 @@ namespace nana
 
 					emit_cancel(es_lister* self, bool for_sel) noexcept : self(self), for_selection(for_sel) {}
 
-					void operator()(category_t::container::value_type& m, const index_pair& item_pos) const
+					void operator()(category_t& cat, const index_pair& item_pos) const
 					{
-						if (for_selection)
-							m.flags.selected = false;
-						else
-							m.flags.checked = false;
-
+						cat.flag(item_pos.item, for_selection, false);
 						self->emit_cs(item_pos, for_selection);
 					}
 				};
@@ -1754,20 +2854,16 @@ namespace nana
 					if (!(for_selection ? single_selection_ : single_check_))
 						return;
 
-					pred_cancel pred{ for_selection };
 					emit_cancel do_cancel{ this, for_selection };
 
 					if (for_selection ? single_selection_category_limited_ : single_check_category_limited_)
 					{
 						auto i = this->get(except.cat);
 
-						std::size_t item_pos = 0;
-						for (auto & m : i->items)
+						for (auto item_pos : i->flagged(for_selection))
 						{
-							if ((item_pos != except.item) && pred(m))
-								do_cancel(m, index_pair{ except.cat, item_pos });
-
-							++item_pos;
+							if (item_pos != except.item)
+								do_cancel(*i, index_pair{ except.cat, item_pos });
 						}
 					}
 					else
@@ -1775,16 +2871,14 @@ namespace nana
 						index_pair cancel_pos;
 						for (auto & cat : categories_)
 						{
-							for (auto & m : cat.items)
+							for (auto item_pos : cat.flagged(for_selection))
 							{
-								if ((cancel_pos != except) && pred(m))
-									do_cancel(m, cancel_pos);
-
-								++cancel_pos.item;
+								cancel_pos.item = item_pos;
+								if (cancel_pos != except)
+									do_cancel(cat, cancel_pos);
 							}
 
 							++cancel_pos.cat;
-							cancel_pos.item = 0;
 						}
 					}
 				}
@@ -1805,7 +2899,6 @@ namespace nana
 					single = true;
 					limited = category_limited;
 
-					pred_cancel pred{ for_selection };
 					emit_cancel cancel{ this, for_selection };
 
 					std::size_t cat_pos = 0;
@@ -1817,19 +2910,14 @@ namespace nana
 						if ((category_limited) || (!selected))
 						{
 							bool ignore = true;	//Ignore the first matched item
-							std::size_t pos = 0;
-							for (auto & m : cat.items)
+							for (auto pos : cat.flagged(for_selection))
 							{
-								if (pred(m))
-								{
-									selected = true;
+								selected = true;
 
-									if (ignore)
-										ignore = false;
-									else
-										cancel(m, index_pair{ cat_pos, pos });
-								}
-								++pos;
+								if (ignore)
+									ignore = false;
+								else
+									cancel(cat, index_pair{ cat_pos, pos });
 							}
 							++cat_pos;
 						}
@@ -1841,13 +2929,9 @@ namespace nana
 								if (skip_cat++ < cat_pos)
 									continue;
 
-								std::size_t pos = 0;
-								for (auto & m : cat.items)
-								{
-									if (pred(m))
-										cancel(m, index_pair{ cat_pos, pos });
-									++pos;
-								}
+								for (auto pos : cat.flagged(for_selection))
+									cancel(cat, index_pair{ cat_pos, pos });
+
 								++cat_pos;
 							}
 							break;
@@ -1865,20 +2949,15 @@ namespace nana
 					return (for_selection ? single_selection_ : single_check_);
 				}
 
+				/// Returns the number of displayed items of a category
 				size_type size_item(size_type cat) const
 				{
-					return get(cat)->items.size();
+					return get(cat)->displayed();
 				}
 
 				bool cat_status(size_type pos, bool for_selection) const
 				{
-					auto & items = get(pos)->items;
-					for (auto & m : items)
-					{
-						if ((for_selection ? m.flags.selected : m.flags.checked) == false)
-							return false;
-					}
-					return true;
+					return get(pos)->all_flagged(for_selection);
 				}
 
 				bool cat_status(size_type pos, bool for_selection, bool value);
@@ -1895,7 +2974,7 @@ namespace nana
                 /// can be used as the absolute position of the last absolute item, or as the display pos of the last displayed item
                 index_pair last() const noexcept
 				{
-					index_pair i{ categories_.size() - 1, categories_.back().items.size() };
+					index_pair i{ categories_.size() - 1, categories_.back().displayed() };
 
 					if (i.cat)
 					{
@@ -1919,7 +2998,7 @@ namespace nana
                 index_pair first() const noexcept
                 {
 					auto i = categories_.cbegin();
-					if (i->items.size())
+					if (i->size())
 						return index_pair{ 0, 0 };
 
 					if (categories_.size() > 1)
@@ -1942,19 +3021,357 @@ namespace nana
 				container::iterator get(size_type pos)
 				{
 					check_range(pos, categories_.size());
-
-					auto i = categories_.begin();
-					std::advance(i, pos);
-					return i;
+					return index_.at(pos);
 				}
 
 				container::const_iterator get(size_type pos) const
 				{
 					check_range(pos, categories_.size());
+					return index_.at(pos);
+				}
 
-					auto i = categories_.cbegin();
-					std::advance(i, pos);
-					return i;
+				/// Returns the position of a category, or npos if the category is not found.
+				size_type position(const category_t* cat) const
+				{
+					return index_.position(cat);
+				}
+
+				/// Updates the lines of a category after its items are inserted or removed, or it is expanded or collapsed.
+				void update_lines(size_type cat)
+				{
+					index_.update(cat);
+				}
+
+				/// Rebuilds the index of categories after the categories are inserted or removed.
+				void invalidate_index() noexcept
+				{
+					index_.invalidate();
+				}
+			private:
+				/// Returns true if the items are kept in the sort order
+				bool _m_sorting() const noexcept
+				{
+					return ((npos != sort_attrs_.column) && sort_attrs_.resort);
+				}
+
+				void _m_sort(category_t& cat)
+				{
+					//A virtual category has no sort order until it is sorted.
+					if (cat.sorted.size() != cat.size())
+						cat.make_sort_order();
+
+					if (cat.sorted.size() < 2)
+						return;
+
+					//The texts of the sorted column are extracted once for each item, rather than the cells
+					//of both operands being made for each comparison.
+					auto const keys = _m_sort_keys(cat);
+					auto const reverse = sort_attrs_.reverse;
+
+					auto weak_ordering_comp = fetch_ordering_comparer(sort_attrs_.column);
+					if (weak_ordering_comp)
+					{
+						std::vector<nana::any*> anyobjs(cat.size());
+						if (cat.virtual_ptr)
+						{
+							for (auto & m : cat.virtual_ptr->decorated)
+								anyobjs[m.first] = m.second.decor().anyobj.get();
+						}
+						else
+						{
+							for (std::size_t i = 0; i < cat.items.size(); ++i)
+								anyobjs[i] = cat.items[i].decor().anyobj.get();
+						}
+
+						//The predicate must be a strict weak ordering.
+						//!comp(x, y) != comp(x, y)
+						//The user-defined comparer may be not thread-safe, it is sorted in this thread.
+						std::stable_sort(cat.sorted.begin(), cat.sorted.end(), [&](std::size_t x, std::size_t y){
+							return weak_ordering_comp(keys[x], anyobjs[x], keys[y], anyobjs[y], reverse);
+						});
+					}
+					else
+					{	//No user-defined comparer is provided, and default comparer is applying.
+						parallel_stable_sort(cat.sorted, [&keys, reverse](std::size_t x, std::size_t y){
+							return (reverse ? keys[x] > keys[y] : keys[x] < keys[y]);
+						});
+					}
+				}
+
+				/// Merges the items which are not in the sort order of a category into it.
+				/**
+				 * If the category is being sorted, the items are sorted and their positions in the sort order are searched by binary search,
+				 * and then the sort order is merged by moving each item once, so that only O(k log n) keys are made for k items rather than
+				 * the whole category being sorted again. An item is placed after the items which are equivalent to it, as a stable sort does.
+				 * Otherwise, the items are displayed at the end of the category.
+				 * @param positions The absolute positions of the items
+				 */
+				void _m_merge_order(category_t& cat, const std::vector<std::size_t>& positions)
+				{
+					//The sort order of a virtual category is identical to the absolute order until it is sorted.
+					if (positions.empty() || (cat.sorted.empty() && cat.virtual_ptr))
+						return;
+
+					auto const size = cat.sorted.size();
+
+					//No throw when the sort order is merged
+					cat.sorted.reserve(size + positions.size());
+
+					if (!_m_sorting())
+					{
+						cat.sorted.insert(cat.sorted.end(), positions.begin(), positions.end());
+						return;
+					}
+
+					auto const reverse = sort_attrs_.reverse;
+					auto weak_ordering_comp = fetch_ordering_comparer(sort_attrs_.column);
+					auto less = [&](const std::string& a, std::size_t x, const std::string& b, std::size_t y){
+						if (weak_ordering_comp)
+							return weak_ordering_comp(a, cat.item(x).decor().anyobj.get(), b, cat.item(y).decor().anyobj.get(), reverse);
+						return (reverse ? a > b : a < b);
+					};
+
+					std::vector<std::string> keys;
+					keys.reserve(positions.size());
+					for (auto pos : positions)
+						keys.emplace_back(_m_sort_key(cat, pos));
+
+					std::vector<std::size_t> order(positions.size());
+					for (std::size_t i = 0; i < order.size(); ++i)
+						order[i] = i;
+
+					std::stable_sort(order.begin(), order.end(), [&](std::size_t x, std::size_t y){
+						return less(keys[x], positions[x], keys[y], positions[y]);
+					});
+
+					//The bounds are ascending because the items are sorted, each one is searched from the previous one.
+					std::vector<std::size_t> bounds;
+					bounds.reserve(order.size());
+
+					auto const begin = cat.sorted.begin();
+					auto bound = begin;
+					for (auto i : order)
+					{
+						bound = std::upper_bound(bound, begin + size, positions[i], [&](std::size_t x, std::size_t y){
+							return less(keys[i], x, _m_sort_key(cat, y), y);
+						});
+						bounds.push_back(static_cast<std::size_t>(bound - begin));
+					}
+
+					//Merges from the end, the items after a bound are moved to their final positions.
+					cat.sorted.resize(size + positions.size());
+
+					auto const seq = cat.sorted.begin();
+					auto last = size;
+					auto dest = cat.sorted.size();
+					for (auto i = order.size(); i > 0; --i)
+					{
+						auto const bound = bounds[i - 1];
+						std::move_backward(seq + bound, seq + last, seq + dest);
+						dest -= last - bound;
+						last = bound;
+
+						seq[--dest] = positions[order[i - 1]];
+					}
+				}
+
+				/// Moves an item to its sorted position after its text of the sorted column is changed.
+				void _m_resort_item(category_t& cat, std::size_t pos)
+				{
+					if (!_m_sorting() || (cat.sorted.size() != cat.size()))
+						return;
+
+					cat.sorted.erase(std::find(cat.sorted.begin(), cat.sorted.end(), pos));
+					try
+					{
+						_m_merge_order(cat, std::vector<std::size_t>(1, pos));
+					}
+					catch (...)
+					{
+						cat.sorted.push_back(pos);
+						throw;
+					}
+				}
+
+				/// Applies an operation which is fed to the model, returns true if the items are inserted, erased or moved in display order.
+				bool _m_apply(category_t& cat, size_type cat_pos, model_guard& guard, model_feed::operation& op, std::vector<index_pair>& updated)
+				{
+					auto const size = cat.size();
+					if (model_feed::kinds::insert == op.kind)
+					{
+						auto const pos = (std::min)(op.pos, size);
+						op.modify(guard, pos);
+						cat.items.emplace(cat.items.begin() + pos);
+						index_.update(cat_pos);
+
+						_m_inserted(cat, pos);
+						return true;
+					}
+
+					if (op.pos >= size)
+						return false;
+
+					if (model_feed::kinds::erase == op.kind)
+					{
+						erase(index_pair{ cat_pos, op.pos });
+						return true;
+					}
+
+					auto const dpos = index_cast_noexcept(index_pair{ cat_pos, op.pos }, false);
+
+					measure_item(cat, op.pos, false);
+					op.modify(guard, op.pos);
+					measure_item(cat, op.pos, true);
+
+					_m_resort_item(cat, op.pos);
+					refilter(cat, op.pos, op.pos + 1);
+
+					auto const now = index_cast_noexcept(index_pair{ cat_pos, op.pos }, false);
+					if (now != dpos)
+						return true;
+
+					if (!now.empty())
+						updated.push_back(now);
+					return false;
+				}
+
+				/// Makes the items of a category with a model again, after the container is modified by a failed operation.
+				void _m_resync(category_t& cat, size_type cat_pos)
+				{
+					cat.extents.clear();
+					cat.items.resize(cat.model_ptr->container()->size());
+
+					cat.make_sort_order();
+					if (_m_sorting())
+						_m_sort(cat);
+
+					refilter(cat);
+					index_.update(cat_pos);
+				}
+
+				/// Places an item which is inserted at the specified absolute position.
+				void _m_inserted(category_t& cat, std::size_t pos)
+				{
+					measure_item(cat, pos, true);
+
+					//The items after the inserted item are moved backward
+					for (auto & abs : cat.sorted)
+					{
+						if (abs >= pos)
+							++abs;
+					}
+					_m_merge_order(cat, std::vector<std::size_t>(1, pos));
+
+					if (cat.filter_ptr)
+					{
+						auto & matched = cat.filter_ptr->matched;
+						matched.insert(matched.begin() + (std::min)(pos, matched.size()), 1);
+						refilter(cat, pos, pos + 1);
+					}
+				}
+
+				/// Tests the items in [first, last) which are marked as matched, the items which don't match the filter are unmarked.
+				void _m_match_items(category_t& cat, category_t::filter_state& flt, std::size_t first, std::size_t last)
+				{
+					if (flt.predicate)
+					{
+						auto const cat_pos = index_.position(&cat);
+						for (auto i = first; i < last; ++i)
+						{
+							if (flt.matched[i])
+								flt.matched[i] = flt.predicate(item_proxy{ ess_, index_pair{ cat_pos, i } });
+						}
+						return;
+					}
+
+					if (cat.model_ptr)
+					{
+						//The cells of a model are made by the translator which may be not thread-safe.
+						auto const container = cat.model_ptr->container();
+						for (auto i = first; i < last; ++i)
+						{
+							if (flt.matched[i])
+							{
+								auto cells = container->to_cells(i);
+								flt.matched[i] = ((flt.column < cells.size()) && contains_text(cells[flt.column].text, flt.query, flt.case_sensitive));
+							}
+						}
+						return;
+					}
+
+					auto const count = last - first;
+					for_each_chunk(count, parallel_chunks(count), [&cat, &flt, first](std::size_t begin, std::size_t end){
+						for (auto i = first + begin; i < first + end; ++i)
+						{
+							if (flt.matched[i])
+							{
+								auto & cells = cat.items[i].cells;
+								flt.matched[i] = ((flt.column < cells.size()) && contains_text(cells.data(flt.column), cells.length(flt.column), flt.query, flt.case_sensitive));
+							}
+						}
+					});
+				}
+
+				/// Updates the display order and the lines of a filtered category
+				void _m_filtered(category_t& cat)
+				{
+					if (cat.filter_ptr)
+					{
+						cat.make_filtered_order();
+						index_.update(index_.position(&cat));
+					}
+				}
+
+				/// Returns the text of the sorted column of an item
+				std::string _m_sort_key(const category_t& cat, std::size_t pos) const
+				{
+					auto const column = sort_attrs_.column;
+					if (cat.model_ptr)
+					{
+						auto cells = cat.model_ptr->container()->to_cells(pos);
+						return (column < cells.size() ? std::move(cells[column].text) : std::string{});
+					}
+
+					return cat.items[pos].cells.text(column);
+				}
+
+				/// Returns the texts of the sorted column of the items by absolute position.
+				/**
+				 * An item which doesn't have the column is sorted as an empty text.
+				 */
+				std::vector<std::string> _m_sort_keys(const category_t& cat) const
+				{
+					auto const column = sort_attrs_.column;
+					std::vector<std::string> keys;
+					keys.reserve(cat.size());
+
+					if (cat.model_ptr)
+					{
+						auto const container = cat.model_ptr->container();
+						for (std::size_t i = 0; i < cat.size(); ++i)
+						{
+							auto cells = container->to_cells(i);
+							keys.emplace_back(column < cells.size() ? std::move(cells[column].text) : std::string{});
+						}
+					}
+					else
+					{
+						for (auto & m : cat.items)
+							keys.emplace_back(m.cells.text(column));
+					}
+					return keys;
+				}
+
+				/// Returns the display position of a line
+				index_pair _m_locate(std::size_t line) const
+				{
+					index_pair dpos{ index_.find(line), npos };
+
+					auto const offset = line - index_.lines_before(dpos.cat);
+					if (offset)
+						dpos.item = offset - 1;
+
+					return dpos;
 				}
 			public:
 				index_pair latest_selected_abs;	//Stands for the latest selected item that selected by last operation. Invalid if it is empty.
@@ -1964,6 +3381,7 @@ namespace nana
 
 				sort_attributes sort_attrs_;	//Attributes of sort
 				container categories_;
+				mutable category_index index_{ categories_ };
 
 				bool	ordered_categories_{false};	///< A switch indicates whether the categories are ordered.
 												/// The ordered categories always creates a new category at a proper position(before the first one which is larger than it).
@@ -2046,6 +3464,22 @@ namespace nana
 					}
 				}mouse_selection;
 
+				/// The state of the last drawing of the items.
+				/**
+				 * If the items are not changed since they were drawn and the lister is only scrolled vertically, the drawn
+				 * items are copied by the distance of scrolling and only the exposed items are drawn.
+				 */
+				struct drawn_part
+				{
+					bool	valid{ false };	///< Indicates whether the drawn items are unchanged
+					rectangle	visual_r;
+					point	origin;
+					index_pair	hovered{ npos, npos };	///< The display position of the highlighted item
+					std::vector<index_pair> dirty;	///< The display positions of the items which are changed since they were drawn, in ascending order
+				}drawn;
+
+				std::unique_ptr<nana::timer> feed_timer;	///< Applies the operations which are fed to the models
+				std::chrono::milliseconds feed_interval{ 40 };
 
 				std::map<pat::detail::abstract_factory_base*, std::deque<std::unique_ptr<inline_pane>>> inline_table, inline_buffered_table;
 
@@ -2069,8 +3503,7 @@ namespace nana
 					if (abs_pos.is_category())
 						return lister.cat_status(abs_pos.cat, for_selection);
 					
-					auto & flags = lister.get(abs_pos.cat)->items.at(abs_pos.item).flags;
-					return (for_selection ? flags.selected : flags.checked);
+					return lister.flag(abs_pos, for_selection);
 				}
 
 				void resize_disp_area()
@@ -2311,8 +3744,126 @@ namespace nana
 					return (lister_s / item_height()) + (with_rest && (lister_s % item_height()) ? 1 : 0);
 				}
 
+				/// Marks the drawn items to be drawn again, it's called when the items are changed.
+				void invalidate_drawn() noexcept
+				{
+					drawn.valid = false;
+					drawn.dirty.clear();
+				}
+
+				/// Starts to apply the operations which are fed to the models, it's called in the GUI thread.
+				void start_feeding()
+				{
+					if (!feed_timer)
+					{
+						feed_timer.reset(new nana::timer{ feed_interval });
+						feed_timer->elapse([this]{
+							apply_feeds();
+						});
+					}
+					feed_timer->start();
+				}
+
+				/// Applies the operations which are fed to the models in a batch.
+				/**
+				 * The feed of a category is removed when all its feeders are destroyed and its operations are applied, the timer
+				 * is stopped when there isn't a feed.
+				 */
+				void apply_feeds()
+				{
+					internal_scope_guard lock;
+
+					bool feeding = false;
+					bool rearranged = false;
+					std::vector<index_pair> updated;
+					for (auto & cat : lister.cat_container())
+					{
+						if (!cat.feed_ptr)
+							continue;
+
+						//No operation is queued after all the feeders are destroyed.
+						auto const abandoned = !cat.feed_ptr->feeding();
+
+						if (lister.apply_feed(cat, updated))
+							rearranged = true;
+
+						if (abandoned)
+							cat.feed_ptr.reset();
+						else
+							feeding = true;
+					}
+
+					if (!feeding)
+						feed_timer->stop();
+
+					if (rearranged)
+						update();
+					else if (!updated.empty())
+						update_rows(updated);
+				}
+
+				/// Updates an item which is changed by the function.
+				/**
+				 * Only the row of the item is drawn and copied to the screen if the item stays at its display position,
+				 * otherwise the listbox is updated.
+				 */
+				template<typename Function>
+				void update_item(const index_pair& abs_pos, Function modify)
+				{
+					auto const disp = lister.index_cast_noexcept(abs_pos, false);
+					auto const displayed = lister.get(abs_pos.cat)->displayed();
+
+					modify();
+
+					if (disp.empty() || (disp != lister.index_cast_noexcept(abs_pos, false)) || (displayed != lister.get(abs_pos.cat)->displayed()))
+						update();
+					else
+						update_rows(std::vector<index_pair>(1, disp));
+				}
+
+				/// Draws the changed items again and copies only their rows to the screen.
+				/**
+				 * The drawn items are kept only if the listbox is displayed, otherwise the listbox is updated.
+				 * @param disp_positions The display positions of the changed items.
+				 */
+				void update_rows(const std::vector<index_pair>& disp_positions)
+				{
+					rectangle list_r;
+					if (!(auto_draw && lister.wd_ptr() && _m_displayed() && rect_lister(list_r)))
+						return update();
+
+					auto & dirty = drawn.dirty;
+					dirty.insert(dirty.end(), disp_positions.begin(), disp_positions.end());
+					std::sort(dirty.begin(), dirty.end());
+					dirty.erase(std::unique(dirty.begin(), dirty.end()), dirty.end());
+
+					//The damaged area is the bounding rectangle of the visible rows.
+					auto const origin_y = content_view->origin().y;
+					auto const item_px = static_cast<int>(item_height());
+					int top = list_r.bottom(), bottom = list_r.y;
+					for (auto & pos : disp_positions)
+					{
+						if ((!pos.is_category()) && (!lister.get(pos.cat)->expand))
+							continue;
+
+						auto const y = list_r.y + content_position(pos) - origin_y;
+						if ((y + item_px <= list_r.y) || (y >= list_r.bottom()))
+							continue;
+
+						top = (std::min)(top, (std::max)(y, list_r.y));
+						bottom = (std::max)(bottom, (std::min)(y + item_px, list_r.bottom()));
+					}
+
+					//The changed items are not visible, they are drawn when they are scrolled into the view.
+					if (top >= bottom)
+						return;
+
+					API::refresh_window(lister.wd_ptr()->handle(), rectangle{ list_r.x, top, list_r.width, static_cast<unsigned>(bottom - top) });
+				}
+
 				void update(bool ignore_auto_draw = false) noexcept
 				{
+					invalidate_drawn();
 					if((auto_draw || ignore_auto_draw) && lister.wd_ptr())
 					{
 						calc_content_size(false);
@@ -2588,6 +4139,17 @@ namespace nana
 					inline_table[factory].emplace_back(std::move(pane_ptr));
 					return ptr;
 				}
+			private:
+				/// Returns true if the listbox and its ancestors are visible.
+				bool _m_displayed() const
+				{
+					for (window wd = lister.wd_ptr()->handle(); wd; wd = API::get_parent_window(wd))
+					{
+						if (!API::visible(wd))
+							return false;
+					}
+					return true;
+				}
 			};
 
 			//definition of iresolver/oresolver
@@ -2839,48 +4401,89 @@ namespace nana
 			}
 			//end class iresolver/oresolver
 
-			unsigned es_lister::column_content_pixels(size_type pos) const
+			//Returns the graphics for measuring the texts, a helper is created if widget graph is empty(when its size is 0).
+			static paint::graphics* measure_graphics(paint::graphics* graph, std::unique_ptr<paint::graphics>& graph_helper)
 			{
-				unsigned max_px = 0;
-				
-				std::unique_ptr<paint::graphics> graph_helper;
-				auto graph = ess_->graph;
 				if (graph->empty())
 				{
-					//Creates a helper if widget graph is empty(when its size is 0).
 					graph_helper.reset(new paint::graphics{ nana::size{ 5, 5 } });
-					graph_helper->typeface(ess_->graph->typeface());
-					graph = graph_helper.get();
+					graph_helper->typeface(graph->typeface());
+					return graph_helper.get();
 				}
+				return graph;
+			}
+
+			unsigned es_lister::column_content_pixels(size_type pos)
+			{
+				unsigned max_px = 0;
+
+				std::unique_ptr<paint::graphics> graph_helper;
+				paint::graphics* graph = nullptr;
 
 				for (auto & cat : categories_)
 				{
-					for (std::size_t i = 0; i < cat.items.size(); ++i)
+					if (!cat.extents.measured(pos))
 					{
-						unsigned content_px = 0;
-						if (cat.model_ptr)
-						{
-							auto model_cells = cat.model_ptr->container()->to_cells(i);
-							if (pos >= model_cells.size())
-								continue;
+						if (!graph)
+							graph = measure_graphics(ess_->graph, graph_helper);
 
-							content_px = graph->text_extent_size(model_cells[pos].text).width;
+						try
+						{
+							cat.extents.measure(pos);
+							for (std::size_t i = 0; i < cat.size(); ++i)
+							{
+								if (cat.model_ptr)
+								{
+									auto model_cells = cat.model_ptr->container()->to_cells(i);
+									if (pos < model_cells.size())
+										cat.extents.add(pos, graph->text_extent_size(model_cells[pos].text).width);
+								}
+								else if (pos < cat.items[i].cells.size())
+									cat.extents.add(pos, graph->text_extent_size(cat.items[i].cells.text(pos)).width);
+							}
 						}
-						else
+						catch (...)
 						{
-							if (pos >= cat.items[i].cells->size())
-								continue;
-
-							content_px = graph->text_extent_size((*cat.items[i].cells)[pos].text).width;
+							//The column is partly measured
+							cat.extents.clear();
+							throw;
 						}
-
-						if (content_px > max_px)
-							max_px = content_px;
 					}
+
+					max_px = (std::max)(max_px, cat.extents.max_pixels(pos));
 				}
 				return max_px;
 			}
 
+			void es_lister::measure_item(category_t& cat, std::size_t pos, bool add)
+			{
+				if (cat.extents.empty())
+					return;
+
+				if (!ess_->graph)
+				{
+					cat.extents.clear();
+					return;
+				}
+
+				std::unique_ptr<paint::graphics> graph_helper;
+				auto graph = measure_graphics(ess_->graph, graph_helper);
+
+				if (cat.model_ptr)
+				{
+					auto model_cells = cat.model_ptr->container()->to_cells(pos);
+					cat.extents.count(model_cells.size(), add, [graph, &model_cells](std::size_t col){
+						return graph->text_extent_size(model_cells[col].text).width;
+					});
+					return;
+				}
+
+				auto & cells = cat.items[pos].cells;
+				cat.extents.count(cells.size(), add, [graph, &cells](std::size_t col){
+					return graph->text_extent_size(cells.text(col)).width;
+				});
+			}
+
 			//es_header::column member functions
 			void es_header::column::_m_refresh() noexcept
 			{
@@ -2931,6 +4534,7 @@ namespace nana
 			{
 				this->font.reset(new paint::font{ column_font });
 
+				ess_->invalidate_drawn();
 				API::refresh_window(*ess_->listbox_ptr);
 			}
 
@@ -2994,18 +4598,29 @@ namespace nana
 				{
 					ess_->lister.throw_if_immutable_model(pos);
 
-					auto model_cells = ess_->lister.at_model_abs(pos);
-					auto & cells = ess_->lister.has_model(pos) ? model_cells : (*ess_->lister.at_abs(pos).cells);
+					auto const has_model = ess_->lister.has_model(pos);
+					auto cells = (has_model ? ess_->lister.at_model_abs(pos) : ess_->lister.at_abs(pos).cells.to_cells());
 
-					if (cells.size() <= column_pos_)
-						cells.resize(column_pos_ + 1);
-
-					if (cells[column_pos_].text != value)
+					if (column_pos_ < cells.size() ? (cells[column_pos_].text != value) : !value.empty())
 					{
+						//The widths of the texts of a model item are counted when the cells are assigned to the model.
+						auto & cat = *ess_->lister.get(pos.cat);
+						if (!has_model)
+							ess_->lister.measure_item(cat, pos.item, false);
+
+						if (cells.size() <= column_pos_)
+							cells.resize(column_pos_ + 1);
+
 						cells[column_pos_].text = value;
 
-						if (model_cells.size())
-							ess_->lister.assign_model(pos, model_cells);
+						if (has_model)
+							ess_->lister.assign_model(pos, cells);
+						else
+						{
+							ess_->lister.at_abs(pos).cells.assign(cells);
+							ess_->lister.measure_item(cat, pos.item, true);
+							ess_->lister.refilter(cat, pos.item, pos.item + 1);
+						}
 
 						ess_->update();
 					}
@@ -3013,7 +4628,7 @@ namespace nana
 
 				void selected(index_type pos) override
 				{
-					if (ess_->lister.at(pos).flags.selected)
+					if (ess_->lister.flag(ess_->lister.index_cast(pos, true), true))
 						return;
 					ess_->lister.select_for_all(false);
 					cat_proxy(ess_, pos.cat).at(pos.item).select(true);
@@ -3040,7 +4655,7 @@ namespace nana
 			{
 				auto& cat = *get(abs_pos.cat);
 
-				if ((abs_pos.item != nana::npos) && (abs_pos.item >= cat.items.size()))
+				if ((abs_pos.item != nana::npos) && (abs_pos.item >= cat.size()))
 					throw std::invalid_argument("listbox: invalid pos to scroll");
 
 				if (!cat.expand)
@@ -3055,9 +4670,15 @@ namespace nana
 					ess_->calc_content_size();
 				}
 
+				auto const dpl_pos = (abs_pos.is_category() ? abs_pos : this->index_cast_noexcept(abs_pos, false));
+
+				//The item is not displayed because of the filter
+				if (dpl_pos.empty())
+					return;
+
 				auto origin = ess_->content_view->origin();
 
-				auto off = this->distance(this->first(), this->index_cast(abs_pos, false)) * ess_->item_height();
+				auto off = this->distance(this->first(), dpl_pos) * ess_->item_height();
 
 				auto screen_px = ess_->content_view->view_area().height;
 
@@ -3095,18 +4716,34 @@ namespace nana
 			void es_lister::erase(const index_pair& pos)
 			{
 				auto & cat = *get(pos.cat);
-				if (pos.item < cat.items.size())
+				if (pos.item < cat.size())
 				{
 					if (cat.model_ptr)
-					{
 						throw_if_immutable_model(cat.model_ptr.get());
+
+					measure_item(cat, pos.item, false);
+
+					if (cat.model_ptr)
 						cat.model_ptr->container()->erase(pos.item);
-					}
 
 					cat.items.erase(cat.items.begin() + pos.item);
-					cat.sorted.erase(std::find(cat.sorted.begin(), cat.sorted.end(), cat.items.size()));
+					index_.update(pos.cat);
 
-					sort();
+					//Removing an item keeps the others in the sort order
+					cat.sorted.erase(std::find(cat.sorted.begin(), cat.sorted.end(), pos.item));
+					for (auto & abs : cat.sorted)
+					{
+						if (abs > pos.item)
+							--abs;
+					}
+
+					if (cat.filter_ptr)
+					{
+						auto & matched = cat.filter_ptr->matched;
+						if (pos.item < matched.size())
+							matched.erase(matched.begin() + pos.item);
+						_m_filtered(cat);
+					}
 				}
 			}
 
@@ -3210,16 +4847,16 @@ namespace nana
 
 					auto const pcell = (cat.model_ptr ? &model_cells : nullptr);
 
-					for (auto i : cat.sorted)
+					for (std::size_t pos = 0; pos < cat.displayed(); ++pos)
 					{
-						auto& item = cat.items[i];
-						if (item.flags.selected || !exp_opt.only_selected_items)
+						auto const i = cat.absolute(pos);
+						if (cat.flag(i, true) || !exp_opt.only_selected_items)
 						{
 							//Test if the category have a model set.
 							if (pcell)
 								cat.model_ptr->container()->to_cells(i).swap(model_cells);
 							
-							list_str += (item.to_string(exp_opt, pcell) + exp_opt.endl);
+							list_str += (cat.item(i).to_string(exp_opt, pcell) + exp_opt.endl);
 						}
 					}
 				}
@@ -3243,17 +4880,14 @@ namespace nana
 				}
 				else
 				{
-					auto & items = get(pos)->items;
-					size_type index = 0;
-					for (auto & m : items)
+					auto & cat = *get(pos);
+					for (size_type index = 0; index < cat.size(); ++index)
 					{
-						if (m.flags.checked != value)
+						if (cat.flag(index, false, value))
 						{
-							m.flags.checked = value;
 							this->emit_cs(index_pair{ pos, index }, false);
 							changed = true;
 						}
-						++index;
 					}
 				}
 				return changed;
@@ -3616,6 +5250,17 @@ namespace nana
 
 					auto const origin = essence_->content_view->origin();
 
+					//The items out of the exposed rectangle are copied from the last drawing.
+					auto const exposed_r = _m_scroll_drawn(visual_r, origin);
+					auto const partial = (exposed_r != visual_r);
+
+					auto & drawn = essence_->drawn;
+					auto const prev_hovered = drawn.hovered;
+					drawn.valid = false;
+
+					std::vector<index_pair> dirty;
+					dirty.swap(drawn.dirty);
+
 					auto const header_margin = essence_->header.margin();
 					if (header_w + header_margin < origin.x + visual_r.width)
 					{
@@ -3648,11 +5293,19 @@ namespace nana
 
 					essence_->inline_buffered_table.swap(essence_->inline_table);
 
+					index_pair hoverred_pos(npos, npos);	//the hovered item.
+
+					//An item is drawn if it is exposed or changed, or if it is highlighted or was highlighted, because the hovered item
+					//is located by the offset to the first displayed item.
+					auto to_draw = [&](const index_pair& pos, int y){
+						return ((!partial) || (pos == hoverred_pos) || (pos == prev_hovered) ||
+							((!exposed_r.empty()) && (y < exposed_r.bottom()) && (y + static_cast<int>(item_height_px) > exposed_r.y)) ||
+							std::binary_search(dirty.begin(), dirty.end(), pos));
+					};
+
 					// The first display is empty when the listbox is empty.
 					if (!first_disp.empty())
 					{
-						index_pair hoverred_pos(npos, npos);	//the hovered item.
-
 						//if where == lister || where == checker, 'second' indicates the offset to the  relative display-order pos of the scroll offset_y which stands for the first item to be displayed in lister.
 						if ((ptr_where.first == parts::list || ptr_where.first == parts::checker) && ptr_where.second != npos)
 						{
@@ -3681,26 +5334,30 @@ namespace nana
 
 							if (idx.cat > 0 && idx.is_category())
 							{
-								_m_draw_categ(*i_categ, visual_r.x - origin.x, item_coord.y, txtoff, header_w, bgcolor,
-									(hoverred_pos.is_category() && (idx.cat == hoverred_pos.cat) ? item_state::highlighted : item_state::normal)
-									);
+								if (to_draw(idx, item_coord.y))
+									_m_draw_categ(*i_categ, visual_r.x - origin.x, item_coord.y, txtoff, header_w, bgcolor,
+										(hoverred_pos.is_category() && (idx.cat == hoverred_pos.cat) ? item_state::highlighted : item_state::normal)
+										);
 								item_coord.y += static_cast<int>(item_height_px);
 								idx.item = 0;
 							}
 
 							if (i_categ->expand)
 							{
-								auto size = i_categ->items.size();
+								auto size = i_categ->displayed();
 								for (; idx.item < size; ++idx.item)
 								{
 									if (item_coord.y > visual_r.bottom())
 										break;
 
-									auto item_pos = lister.index_cast(index_pair{ idx.cat, idx.item }, true);	//convert display position to absolute position
+									if (to_draw(idx, item_coord.y))
+									{
+										auto item_pos = lister.index_cast(index_pair{ idx.cat, idx.item }, true);	//convert display position to absolute position
 
-									_m_draw_item(*i_categ, item_pos, item_coord, txtoff, header_w, visual_r, columns, bgcolor, fgcolor,
-										(idx == hoverred_pos ? item_state::highlighted : item_state::normal)
-										);
+										_m_draw_item(*i_categ, item_pos, item_coord, txtoff, header_w, visual_r, columns, bgcolor, fgcolor,
+											(idx == hoverred_pos ? item_state::highlighted : item_state::normal)
+											);
+									}
 
 									item_coord.y += static_cast<int>(item_height_px);
 								}
@@ -3738,9 +5395,60 @@ namespace nana
 						box_graph.rectangle(false, essence_->scheme_ptr->selection_box.get_color());
 
 						essence_->graph->blend(rectangle{ essence_->coordinate_cast(box_position, false), box_size }, box_graph, {}, 0.5);
+						return;
 					}
+
+					drawn.valid = true;
+					drawn.visual_r = visual_r;
+					drawn.origin = origin;
+					drawn.hovered = hoverred_pos;
 				}
 			private:
+				/// Copies the drawn items if the lister is only scrolled vertically or some items are changed since they were drawn.
+				/**
+				 * @return The rectangle where the items are exposed by scrolling, or the visual rectangle if the items are not kept.
+				 */
+				rectangle _m_scroll_drawn(const rectangle& visual_r, const point& origin) const
+				{
+					auto & drawn = essence_->drawn;
+					auto const distance = origin.y - drawn.origin.y;
+
+					//The inline widgets and the transparent background are placed by drawing all the items.
+					if ((!drawn.valid) || ((0 == distance) && drawn.dirty.empty()) || (drawn.visual_r != visual_r) || (drawn.origin.x != origin.x) ||
+						(static_cast<unsigned>(std::abs(distance)) >= visual_r.height) || essence_->mouse_selection.started ||
+						API::is_transparent_background(essence_->listbox_ptr->handle()) || _m_has_inline())
+						return visual_r;
+
+					//Only the changed items are drawn.
+					if (0 == distance)
+						return rectangle{ visual_r.position(), size{} };
+
+					auto const graph = essence_->graph;
+					auto const height = visual_r.height - static_cast<unsigned>(std::abs(distance));
+					if (distance > 0)
+					{
+						//Scrolled down, the drawn items are moved up.
+						graph->bitblt(rectangle{ visual_r.x, visual_r.y, visual_r.width, height }, *graph, point{ visual_r.x, visual_r.y + distance });
+						return rectangle{ visual_r.x, visual_r.y + static_cast<int>(height), visual_r.width, static_cast<unsigned>(distance) };
+					}
+
+					graph->bitblt(rectangle{ visual_r.x, visual_r.y - distance, visual_r.width, height }, *graph, visual_r.position());
+					return rectangle{ visual_r.x, visual_r.y, visual_r.width, static_cast<unsigned>(-distance) };
+				}
+
+				bool _m_has_inline() const
+				{
+					for (auto & cat : essence_->lister.cat_container())
+					{
+						for (auto & factory : cat.factories)
+						{
+							if (factory)
+								return true;
+						}
+					}
+					return false;
+				}
+
 				void _m_draw_categ(const category_t& categ, int x, int y, int txtoff, unsigned width, nana::color bgcolor, item_state state)
 				{
 					const auto item_height = essence_->item_height();
@@ -3749,9 +5457,9 @@ namespace nana
 					auto graph = essence_->graph;
 
 					item_data item;
-					item.flags.selected = categ.selected();
+					auto const selected = categ.selected();
 
-					this->_m_draw_item_bground(bground_r, bgcolor, {}, state, item);
+					this->_m_draw_item_bground(bground_r, bgcolor, {}, state, item, selected);
 
 					color txt_color{ static_cast<color_rgb>(0x3399) };
 
@@ -3775,7 +5483,7 @@ namespace nana
 					if (categ.display_number)
 					{
 						//Display the number of items in the category
-						native_string_type str = to_nstring('(' + std::to_string(categ.items.size()) + ')');
+						native_string_type str = to_nstring('(' + std::to_string(categ.displayed()) + ')');
 						graph->string({ x + 25 + static_cast<int>(text_px), y + txtoff }, str);
 						text_px += graph->text_extent_size(str).width;
 					}
@@ -3788,11 +5496,11 @@ namespace nana
 					}
 
 					//Draw selecting inner rectangle
-					if (item.flags.selected && (categ.expand == false))
+					if (selected && (categ.expand == false))
 						_m_draw_item_border(y);
 				}
 
-				color _m_draw_item_bground(const rectangle& bground_r, color bgcolor, color cell_color, item_state state, const item_data& item)
+				color _m_draw_item_bground(const rectangle& bground_r, color bgcolor, color cell_color, item_state state, const item_data& item, bool selected)
 				{
 					auto graph = essence_->graph;
 
@@ -3801,7 +5509,7 @@ namespace nana
 					if (is_transparent)
 						bgcolor = color{};
 
-					if (item.flags.selected)
+					if (selected)
 					{
 						bgcolor = essence_->scheme_ptr->item_selected;
 
@@ -3810,12 +5518,12 @@ namespace nana
 					}
 					else if (!cell_color.invisible())
 						bgcolor = cell_color;
-					else if (!item.bgcolor.invisible())
-						bgcolor = item.bgcolor;
+					else if (!item.decor().bgcolor.invisible())
+						bgcolor = item.decor().bgcolor;
 
 					if (item_state::highlighted == state)
 					{
-						if (item.flags.selected)
+						if (selected)
 							bgcolor = bgcolor.blend(essence_->scheme_ptr->item_highlighted, 0.5);
 						else
 							bgcolor = bgcolor.blend(essence_->scheme_ptr->item_highlighted, 0.7);
@@ -3848,18 +5556,16 @@ namespace nana
 					              item_state state
 					)
 				{
-					auto & item = cat.items[item_pos.item];
-
-					std::vector<cell> model_cells;
-					if (cat.model_ptr)
-					{
-						model_cells = cat.model_ptr->container()->to_cells(item_pos.item);
-					}
+					auto & item = cat.item(item_pos.item);
+					auto const selected = cat.flag(item_pos.item, true);
+					auto const checked = cat.flag(item_pos.item, false);
 
-					auto & cells = (cat.model_ptr ? model_cells : *item.cells);
+					//Only the displayed items are drawn, their cells are made for drawing.
+					auto cells = (cat.model_ptr ? cat.model_ptr->container()->to_cells(item_pos.item) : item.cells.to_cells());
 
-					if(!item.fgcolor.invisible())
-						fgcolor = item.fgcolor;
+					auto & decor = item.decor();
+					if(!decor.fgcolor.invisible())
+						fgcolor = decor.fgcolor;
 
 					const unsigned columns_shown_width = (std::min)(content_r.width, header_width - essence_->content_view->origin().x);
 
@@ -3871,7 +5577,7 @@ namespace nana
 						coord.y,
 						columns_shown_width + essence_->content_view->origin().x,
 						essence_->item_height() };
-					auto const state_bgcolor = this->_m_draw_item_bground(bground_r, bgcolor, {}, state, item);
+					auto const state_bgcolor = this->_m_draw_item_bground(bground_r, bgcolor, {}, state, item, selected);
 
 					//The position of column in x-axis.
 					int column_x = coord.x;
@@ -3909,18 +5615,18 @@ namespace nana
 									}
 
 									using state = facade<element::crook>::state;
-									crook_renderer_.check(item.flags.checked ? state::checked : state::unchecked);
+									crook_renderer_.check(checked ? state::checked : state::unchecked);
 								}
 
 								if (essence_->if_image)
 								{
 									//Draw the image in the 1st column in display order
-									if (item.img)
+									if (decor.img)
 									{
-										nana::rectangle imgt(item.img_show_size);
+										nana::rectangle imgt(decor.img_show_size);
 										img_r = imgt;
-										img_r.x = content_pos + coord.x + 2 + (16 - static_cast<int>(item.img_show_size.width)) / 2;  // center in 16 - geom scheme?
-										img_r.y = coord.y + (static_cast<int>(essence_->item_height()) - static_cast<int>(item.img_show_size.height)) / 2; // center
+										img_r.x = content_pos + coord.x + 2 + (16 - static_cast<int>(decor.img_show_size.width)) / 2;  // center in 16 - geom scheme?
+										img_r.y = coord.y + (static_cast<int>(essence_->item_height()) - static_cast<int>(decor.img_show_size.height)) / 2; // center
 									}
 									content_pos += 18;  // image width, geom scheme?
 								}
@@ -3965,8 +5671,8 @@ namespace nana
 									inline_wdg->pane_widget.size(sz);
 									inline_wdg->inline_ptr->resize(sz);
 
-									inline_wdg->inline_ptr->notify_status(status_type::selected, item.flags.selected);
-									inline_wdg->inline_ptr->notify_status(status_type::checked, item.flags.checked);
+									inline_wdg->inline_ptr->notify_status(status_type::selected, selected);
+									inline_wdg->inline_ptr->notify_status(status_type::checked, checked);
 									
 									inline_wdg->indicator->attach(item_pos, inline_wdg);
 
@@ -3995,7 +5701,7 @@ namespace nana
 									col_fgcolor = m_cell.custom_format->fgcolor;
 
 									bground_r = rectangle{ column_x, coord.y, col.width_px, essence_->item_height() };
-									col_bgcolor = this->_m_draw_item_bground(bground_r, bgcolor, m_cell.custom_format->bgcolor, state, item);
+									col_bgcolor = this->_m_draw_item_bground(bground_r, bgcolor, m_cell.custom_format->bgcolor, state, item, selected);
 								}
 								else
 									col_bgcolor = state_bgcolor;
@@ -4020,8 +5726,8 @@ namespace nana
 							{
 								if (essence_->checkable)
 									crook_renderer_.draw(*graph, col_bgcolor, col_fgcolor, essence_->checkarea(column_x, coord.y), estate);
-								if (item.img)
-									item.img.stretch(rectangle{ item.img.size() }, *graph, img_r);
+								if (decor.img)
+									decor.img.stretch(rectangle{ decor.img.size() }, *graph, img_r);
 							}
 
 							if (display_order > 0)
@@ -4032,7 +5738,7 @@ namespace nana
 					}
 
 					//Draw selecting inner rectangle
-					if (item.flags.selected)
+					if (selected)
 						_m_draw_item_border(coord.y);
 				}
 
@@ -4143,11 +5849,15 @@ namespace nana
 
 				void trigger::typeface_changed(graph_reference graph)
 				{
+					essence_->invalidate_drawn();
+
 					essence_->text_height = 0;
 					unsigned as, ds, il;
 					if (graph.text_metrics(as, ds, il))
 						essence_->text_height = as + ds;
 
+					essence_->lister.invalidate_extents();
+
 					essence_->calc_content_size(true);
 				}
 
@@ -4200,6 +5910,8 @@ namespace nana
 					{
 						// moving a grabbed header 
 						need_refresh = drawer_header_->grab_move(pos_in_header);
+						if (need_refresh)
+							essence_->invalidate_drawn();
 					}
 					else if(essence_->calc_where(arg.pos))
 					{
@@ -4226,6 +5938,7 @@ namespace nana
 
 					if (essence_->mouse_selection.started)
 					{
+						essence_->invalidate_drawn();
 						essence_->update_mouse_selection(arg.pos);
 
 						//Don't deselect items if the mouse selection is started
@@ -4262,6 +5975,9 @@ namespace nana
 				{
 					using item_state = essence::item_state;
 					using parts = essence::parts;
+
+					essence_->invalidate_drawn();
+
 					bool update = false;
 
 					essence_->mouse_selection.reverse_selection = false;
@@ -4288,7 +6004,7 @@ namespace nana
 
 						if ((essence_->column_from_pos(arg.pos.x) != npos) && !item_pos.empty())
 						{
-							auto * item_ptr = (item_pos.is_category() ? nullptr : &lister.at(item_pos));
+							auto * item_ptr = (item_pos.is_category() ? nullptr : &(*lister.get(item_pos.cat)));
 
 							const auto abs_item_pos = lister.index_cast_noexcept(item_pos, true, item_pos);	//convert display position to absolute position
 
@@ -4372,7 +6088,7 @@ namespace nana
 
 								if(item_ptr)
 								{
-									if (item_ptr->flags.selected != new_selected_status)
+									if (item_ptr->flag(abs_item_pos.item, true) != new_selected_status)
 									{
 										if (new_selected_status)
 										{
@@ -4383,7 +6099,7 @@ namespace nana
 										else if (essence_->lister.latest_selected_abs == abs_item_pos)
 											essence_->lister.latest_selected_abs.set_both(npos);
 
-										item_ptr->flags.selected = new_selected_status;
+										item_ptr->flag(abs_item_pos.item, true, new_selected_status);
 										lister.emit_cs(abs_item_pos, true);
 									}
 								}
@@ -4398,10 +6114,11 @@ namespace nana
 							{
 								if (item_ptr)
 								{
-									item_ptr->flags.checked = !item_ptr->flags.checked;
+									auto const checked = !item_ptr->flag(abs_item_pos.item, false);
+									item_ptr->flag(abs_item_pos.item, false, checked);
 									lister.emit_cs(abs_item_pos, false);
 
-									if (item_ptr->flags.checked)
+									if (checked)
 										lister.cancel_others_if_single_enabled(false, abs_item_pos);
 								}
 								else if (!lister.single_status(false))	//not single checked
@@ -4449,6 +6166,8 @@ namespace nana
 					using item_state = essence::item_state;
 					using parts = essence::parts;
 
+					essence_->invalidate_drawn();
+
 					auto prev_state = essence_->ptr_state;
 					essence_->ptr_state = item_state::highlighted;
 
@@ -4496,6 +6215,8 @@ namespace nana
 				{
 					using parts = essence::parts;
 
+					essence_->invalidate_drawn();
+
 					if (parts::header == essence_->pointer_where.first)
 					{
 						if (cursor::size_we == essence_->lister.wd_ptr()->cursor())
@@ -4542,6 +6263,8 @@ namespace nana
 
 				void trigger::resized(graph_reference graph, const arg_resized&)
 				{
+					essence_->invalidate_drawn();
+
 					essence_->resize_disp_area();
 
 					refresh(graph);
@@ -4550,6 +6273,8 @@ namespace nana
 
 				void trigger::key_press(graph_reference graph, const arg_keyboard& arg)
 				{
+					essence_->invalidate_drawn();
+
 					auto & list = essence_->lister;
 					// Exit if list is empty
 					if (list.first().empty())
@@ -4695,6 +6420,8 @@ namespace nana
 
 				void trigger::key_char(graph_reference graph, const arg_keyboard& arg)
 				{
+					essence_->invalidate_drawn();
+
 					switch(arg.key)
 					{
 					case keyboard::copy:
@@ -4768,15 +6495,16 @@ namespace nana
 				item_proxy & item_proxy::check(bool ck, bool scroll_view)
 				{
 					internal_scope_guard lock;
-					auto & m = cat_->items.at(pos_.item);
-					if(m.flags.checked != ck)
+					if(cat_->flag(pos_.item, false, ck))
 					{
-						m.flags.checked = ck;
 						ess_->lister.emit_cs(pos_, false);
 						if (scroll_view)
 						{
 							if (ess_->lister.get(pos_.cat)->expand)
+							{
 								ess_->lister.get(pos_.cat)->expand = false;
+								ess_->lister.update_lines(pos_.cat);
+							}
 
 							if (!this->displayed())
 								ess_->lister.scroll_into_view(pos_, (ess_->first_display() > this->to_display() ? view_action::top_view : view_action::bottom_view));
@@ -4789,7 +6517,7 @@ namespace nana
 
 				bool item_proxy::checked() const
 				{
-					return cat_->items.at(pos_.item).flags.checked;
+					return cat_->flag(pos_.item, false);
 				}
 
 				/// is ignored if no change (maybe set last_selected anyway??), but if change emit event, deselect others if need ans set/unset last_selected
@@ -4798,17 +6526,13 @@ namespace nana
 					internal_scope_guard lock;
 
 					//pos_ never represents a category if this item_proxy is available.
-					auto & m = cat_->items.at(pos_.item);       // a ref to the real item
-
 					//ignore if no change
-					if(m.flags.selected == s)
+					if(!cat_->flag(pos_.item, true, s))      // actually change selection
 						return *this;
 
-					m.flags.selected = s;                       // actually change selection
-
 					ess_->lister.emit_cs(this->pos_, true);
 
-					if (m.flags.selected)
+					if (s)
 					{
 						ess_->lister.cancel_others_if_single_enabled(true, pos_);	//Cancel all selections except pos_ if single_selection is enabled.
 						ess_->lister.latest_selected_abs = pos_;
@@ -4825,31 +6549,33 @@ namespace nana
 
 				bool item_proxy::selected() const
 				{
-					return cat_->items.at(pos_.item).flags.selected;
+					return cat_->flag(pos_.item, true);
 				}
 
 				item_proxy & item_proxy::bgcolor(const nana::color& col)
 				{
-					cat_->items.at(pos_.item).bgcolor = col;
-					ess_->update();
+					ess_->update_item(pos_, [&]{
+						cat_->mutable_item(pos_.item).decorate().bgcolor = col;
+					});
 					return *this;
 				}
 
 				nana::color item_proxy::bgcolor() const
 				{
-					return cat_->items.at(pos_.item).bgcolor;
+					return cat_->item(pos_.item).decor().bgcolor;
 				}
 
 				item_proxy& item_proxy::fgcolor(const nana::color& col)
 				{
-					cat_->items.at(pos_.item).fgcolor = col;
-					ess_->update();
+					ess_->update_item(pos_, [&]{
+						cat_->mutable_item(pos_.item).decorate().fgcolor = col;
+					});
 					return *this;
 				}
 
 				nana::color item_proxy::fgcolor() const
 				{
-					return cat_->items.at(pos_.item).fgcolor;
+					return cat_->item(pos_.item).decor().fgcolor;
 				}
 
 				std::size_t item_proxy::columns() const noexcept
@@ -4864,37 +6590,40 @@ namespace nana
 
 				item_proxy& item_proxy::text(size_type col, cell cl)
 				{
-					ess_->lister.text(cat_, pos_.item, col, std::move(cl), columns());
-					ess_->update();
+					ess_->update_item(pos_, [&]{
+						ess_->lister.text(cat_, pos_.item, col, std::move(cl), columns());
+					});
 					return *this;
 				}
 
 				item_proxy& item_proxy::text(size_type col, std::string str)
 				{
-					ess_->lister.text(cat_, pos_.item, col, std::move(str), columns());
-					ess_->update();
+					ess_->update_item(pos_, [&]{
+						ess_->lister.text(cat_, pos_.item, col, std::move(str), columns());
+					});
 					return *this;
 				}
 
 				item_proxy& item_proxy::text(size_type col, const std::wstring& str)
 				{
-					ess_->lister.text(cat_, pos_.item, col, to_utf8(str), columns());
-					ess_->update();
+					ess_->update_item(pos_, [&]{
+						ess_->lister.text(cat_, pos_.item, col, to_utf8(str), columns());
+					});
 					return *this;
 				}
 
 				std::string item_proxy::text(size_type col) const
 				{
-					return cat_->cells(pos_.item).at(col).text;
+					return cat_->cell_text(pos_.item, col);
 				}
 
 				void item_proxy::icon(const nana::paint::image& img)
 				{
 					if (img)
 					{
-						auto & item = cat_->items.at(pos_.item);
-						item.img = img;
-						nana::fit_zoom(img.size(), nana::size(16, 16), item.img_show_size);
+						auto & decor = cat_->mutable_item(pos_.item).decorate();
+						decor.img = img;
+						nana::fit_zoom(img.size(), nana::size(16, 16), decor.img_show_size);
 
 						ess_->if_image = true;
 						ess_->update();
@@ -4948,7 +6677,7 @@ namespace nana
 				// Behavior of Iterator
 				item_proxy & item_proxy::operator++()
 				{
-					if (++pos_.item >= cat_->items.size())
+					if (++pos_.item >= cat_->size())
 						cat_ = nullptr;
 
 					return *this;
@@ -4959,7 +6688,7 @@ namespace nana
 				{
 					item_proxy ip(*this);
 
-					if (++pos_.item >= cat_->items.size())
+					if (++pos_.item >= cat_->size())
 						cat_ = nullptr;
 					return ip;
 				}
@@ -5031,6 +6760,19 @@ namespace nana
 				}
 			//end class item_proxy
 
+			//Clears the cells which are generated by the oresolver for the nullptr
+			static void clear_invalid_cells(std::vector<cell>& cells)
+			{
+				for (auto & cl : cells)
+				{
+					if (cl.text.size() == 1 && cl.text[0] == wchar_t(0))
+					{
+						cl.text.clear();
+						cl.custom_format.reset();
+					}
+				}
+			}
+
 			//class cat_proxy
 
 			//the member cat_ is used for fast accessing to the category
@@ -5045,12 +6787,9 @@ namespace nana
 					:	ess_(ess),
 						cat_(cat)
 				{
-					for (auto & m : ess->lister.cat_container())
-					{
-						if (&m == cat)
-							break;
-						++pos_;
-					}
+					pos_ = ess->lister.position(cat);
+					if (npos == pos_)
+						pos_ = ess->lister.cat_container().size();
 				}
 
 				model_guard cat_proxy::model()
@@ -5058,9 +6797,102 @@ namespace nana
 					if (!cat_->model_ptr)
 						throw std::runtime_error("nana::listbox has not a model for the category");
 
+					//The items may be modified through the guard, the columns are measured again.
+					cat_->extents.clear();
 					return{ cat_->model_ptr.get() };
 				}
 
+				void cat_proxy::append_range(std::vector<std::vector<cell>>&& rows)
+				{
+					if (rows.empty())
+						return;
+
+					for (auto & cells : rows)
+						clear_invalid_cells(cells);
+
+					internal_scope_guard lock;
+
+					auto const first = cat_->items.size();
+					try
+					{
+						if (cat_->model_ptr)
+						{
+							es_lister::throw_if_immutable_model(cat_->model_ptr.get());
+
+							auto container = cat_->model_ptr->container();
+							for (auto & cells : rows)
+							{
+								//The row is appended to the container first, and an item is created for it
+								//only when the row is complete, the items never outnumber the rows of the container.
+								auto item_index = container->size();
+								container->emplace_back();
+								try
+								{
+									container->assign(item_index, cells);
+									cat_->items.emplace_back();
+								}
+								catch (...)
+								{
+									container->erase(item_index);
+									throw;
+								}
+							}
+						}
+						else
+						{
+							auto const cols = columns();
+							for (auto & cells : rows)
+							{
+								cells.resize(cols);
+								cat_->items.emplace_back(std::move(cells));
+							}
+						}
+					}
+					catch (...)
+					{
+						//Keeps the items which have been appended
+						ess_->lister.update_lines(pos_);
+						ess_->lister.place_items(*cat_, first);
+						throw;
+					}
+
+					ess_->lister.update_lines(pos_);
+					ess_->lister.place_items(*cat_, first);
+					ess_->update();
+				}
+
+				void cat_proxy::reserve(size_type items)
+				{
+					internal_scope_guard lock;
+
+					//The items are stored by blocks which are never moved, only the sort order needs the storage.
+					cat_->sorted.reserve(cat_->size() + items);
+				}
+
+				void cat_proxy::filter(size_type column, std::string query, bool case_sensitive)
+				{
+					internal_scope_guard lock;
+					ess_->lister.filter(*cat_, column, std::move(query), case_sensitive);
+					ess_->calc_content_size();
+					ess_->update();
+				}
+
+				void cat_proxy::filter(std::function<bool(const item_proxy&)> pred)
+				{
+					internal_scope_guard lock;
+					ess_->lister.filter(*cat_, std::move(pred));
+					ess_->calc_content_size();
+					ess_->update();
+				}
+
+				void cat_proxy::unfilter()
+				{
+					internal_scope_guard lock;
+					ess_->lister.unfilter(*cat_);
+					ess_->calc_content_size();
+					ess_->update();
+				}
+
 				void cat_proxy::append(std::initializer_list<std::string> arg)
 				{
 					const auto items = columns();
@@ -5128,6 +6960,7 @@ namespace nana
 					if ((expand != cat_->expand) && pos_)
 					{
 						cat_->expand = expand;
+						ess_->lister.update_lines(pos_);
 						ess_->update();
 					}
 					return *this;
@@ -5174,8 +7007,7 @@ namespace nana
 
 					ess_->lister.throw_if_immutable_model(index_pair{ pos_ });
 
-					cat_->sorted.push_back(cat_->items.size());
-
+					auto const first = cat_->items.size();
 					if (cat_->model_ptr)
 					{
 						const auto cont = cat_->model_ptr->container();
@@ -5193,6 +7025,68 @@ namespace nana
 					else
 						cat_->items.emplace_back(std::move(s));
 
+					ess_->lister.update_lines(pos_);
+					ess_->lister.place_items(*cat_, first);
+					ess_->update();
+				}
+
+				void cat_proxy::virtual_model(size_type rows, std::function<std::vector<cell>(size_type pos)> fetcher)
+				{
+					internal_scope_guard lock;
+
+					if (ess_->listbox_ptr)
+					{
+						cat_->model_ptr.reset(new virtual_model_container{ rows, std::move(fetcher) });
+						cat_->virtual_ptr.reset(new category_t::virtual_rows);
+						cat_->feed_ptr.reset();
+						cat_->virtual_ptr->size = rows;
+						cat_->items.clear();
+						cat_->extents.clear();
+
+						//The sort order is made when the category is sorted.
+						cat_->sorted.clear();
+						ess_->lister.update_lines(pos_);
+						ess_->lister.sort();
+						ess_->lister.refilter(*cat_);
+
+						ess_->update();
+					}
+				}
+
+				void cat_proxy::virtual_size(size_type rows)
+				{
+					internal_scope_guard lock;
+
+					if (!cat_->virtual_ptr)
+						throw std::runtime_error("nana::listbox the category is not virtual");
+
+					auto & vrows = *cat_->virtual_ptr;
+					auto const old_rows = vrows.size;
+					if (rows < vrows.size)
+					{
+						vrows.selected.erase(rows, vrows.size);
+						vrows.checked.erase(rows, vrows.size);
+						vrows.decorated.erase(vrows.decorated.lower_bound(rows), vrows.decorated.end());
+
+						auto & latest = ess_->lister.latest_selected_abs;
+						if ((latest.cat == pos_) && (latest.item != npos) && (latest.item >= rows))
+							latest.set_both(npos);
+					}
+
+					vrows.size = rows;
+					cat_->extents.clear();
+					static_cast<virtual_model_container*>(cat_->model_ptr.get())->container()->resize(rows);
+					ess_->lister.update_lines(pos_);
+
+					if (!cat_->sorted.empty())
+					{
+						cat_->sorted.clear();
+						ess_->lister.sort();
+					}
+
+					//Only the appended rows are tested by the filter
+					ess_->lister.refilter(*cat_, old_rows);
+
 					ess_->update();
 				}
 
@@ -5200,7 +7094,7 @@ namespace nana
 				item_proxy cat_proxy::begin() const
 				{
 					auto i = ess_->lister.get(pos_);
-					if (i->items.empty())
+					if (0 == i->size())
 						return end();
 
 					return item_proxy(ess_, index_pair(pos_, 0));
@@ -5232,10 +7126,10 @@ namespace nana
 
 				item_proxy cat_proxy::back() const
 				{
-					if (cat_->items.empty())
+					if (0 == cat_->size())
 						throw std::runtime_error("listbox.back() no element in the container.");
 
-					return item_proxy(ess_, index_pair(pos_, cat_->items.size() - 1));
+					return item_proxy(ess_, index_pair(pos_, cat_->size() - 1));
 				}
 
 				size_type cat_proxy::index_cast(size_type from, bool from_display_order) const
@@ -5250,7 +7144,7 @@ namespace nana
 
 				size_type cat_proxy::size() const
 				{
-					return cat_->items.size();
+					return cat_->size();
 				}
 
 				// Behavior of Iterator
@@ -5342,15 +7236,7 @@ namespace nana
 
 				void cat_proxy::_m_append(std::vector<cell> && cells)
 				{
-					//check invalid cells
-					for (auto & cl : cells)
-					{
-						if (cl.text.size() == 1 && cl.text[0] == wchar_t(0))
-						{
-							cl.text.clear();
-							cl.custom_format.reset();
-						}
-					}
+					clear_invalid_cells(cells);
 
 					internal_scope_guard lock;
 
@@ -5372,7 +7258,8 @@ namespace nana
 						cat_->items.emplace_back(std::move(cells));
 					}
 
-					cat_->sorted.push_back(cat_->items.size() - 1);
+					ess_->lister.update_lines(pos_);
+					ess_->lister.place_items(*cat_, cat_->items.size() - 1);
 				}
 
 				void cat_proxy::_m_try_append_model(const const_virtual_pointer& dptr)
@@ -5386,8 +7273,9 @@ namespace nana
 					if (!cat_->model_ptr->container()->push_back(dptr))
 						throw std::invalid_argument("nana::listbox, the type of operand object is mismatched with model container value_type");
 
-					cat_->sorted.push_back(cat_->items.size());
 					cat_->items.emplace_back();
+					ess_->lister.update_lines(pos_);
+					ess_->lister.place_items(*cat_, cat_->items.size() - 1);
 				}
 
 				void cat_proxy::_m_cat_by_pos() noexcept
@@ -5410,17 +7298,33 @@ namespace nana
 					ess_->update();
 				}
 
+				std::shared_ptr<model_feed> cat_proxy::_m_feed()
+				{
+					internal_scope_guard lock;
+
+					if (!cat_->feed_ptr)
+						cat_->feed_ptr = std::make_shared<model_feed>();
+
+					ess_->start_feeding();
+					return cat_->feed_ptr;
+				}
+
 				void cat_proxy::_m_reset_model(model_interface* p)
 				{
 					if (ess_->listbox_ptr)
 					{
 						cat_->model_ptr.reset(p);
+						cat_->virtual_ptr.reset();
+						cat_->feed_ptr.reset();
 						cat_->items.clear();
+						cat_->extents.clear();
 
 						cat_->items.resize(cat_->model_ptr->container()->size());
+						ess_->lister.update_lines(pos_);
 
 						cat_->make_sort_order();
 						ess_->lister.sort();
+						ess_->lister.refilter(*cat_);
 
 						//Don't ignore the auto-draw flag for performance enhancement.
 						ess_->update();
@@ -5443,6 +7347,12 @@ namespace nana
     {
     }
 
+	//Implementation of arg_listbox_bulk
+	arg_listbox_bulk::arg_listbox_bulk(const nana::drawerbase::listbox::cat_proxy& cat, bool selected) noexcept
+		: category(cat), selected(selected)
+	{
+	}
+
 	//class listbox
 
 		listbox::listbox(window wd, bool visible)
@@ -5479,6 +7389,15 @@ namespace nana
 			}
 		}
 
+		void listbox::feed_interval(std::chrono::milliseconds ms)
+		{
+			internal_scope_guard lock;
+			auto & ess = _m_ess();
+			ess.feed_interval = ms;
+			if (ess.feed_timer)
+				ess.feed_timer->interval(ms);
+		}
+
 		void listbox::scroll(bool to_bottom, size_type cat_pos)
 		{
 			internal_scope_guard lock;
@@ -5502,6 +7421,10 @@ namespace nana
 			else
 				pos.item = ess.lister.size_item(cat_pos) ? 0 : ::nana::npos;
 
+			//The position of the first/last displayed item is converted to an absolute position
+			if (!pos.is_category())
+				pos = ess.lister.index_cast(pos, true);
+
 			this->scroll(to_bottom, pos);
 		}
 
@@ -5613,9 +7536,9 @@ namespace nana
 			
 			if (!empty())
 			{
-				auto & item = ess.lister.at(pos);
-				item.bgcolor = bgcolor();
-				item.fgcolor = fgcolor();
+				auto & decor = ess.lister.at(pos).decorate();
+				decor.bgcolor = bgcolor();
+				decor.fgcolor = fgcolor();
 				ess.update();
 			}
 		}
@@ -5711,13 +7634,13 @@ namespace nana
 				{
 					if (0 < pos.cat)
 						--pos.cat;
-					pos.item = this->size_item(pos.cat);
+					pos.item = _m_ess().lister.size_item(pos.cat);
 				}
 				return pos;
 
 			}
 			else if (return_end)
-				return index_pair{ this->size_categ() - 1, this->size_item(this->size_categ() - 1) };
+				return index_pair{ this->size_categ() - 1, _m_ess().lister.size_item(this->size_categ() - 1) };
 
 			return index_pair{ npos, npos };
 		}
@@ -5878,15 +7801,20 @@ namespace nana
 			for (auto & pos : indexes)
 			{
 				auto & cat = *ess.lister.get(pos.cat);
-				if (pos.item < cat.items.size())
+				if (pos.item < cat.size())
 				{
 					if (cat.model_ptr)
-					{
 						drawerbase::listbox::es_lister::throw_if_immutable_model(cat.model_ptr.get());
+
+					ess.lister.measure_item(cat, pos.item, false);
+
+					if (cat.model_ptr)
 						cat.model_ptr->container()->erase(pos.item);
-					}
 
 					cat.items.erase(cat.items.begin() + pos.item);
+
+					if (cat.filter_ptr && (pos.item < cat.filter_ptr->matched.size()))
+						cat.filter_ptr->matched.erase(cat.filter_ptr->matched.begin() + pos.item);
 				}
 			}
 
@@ -5897,7 +7825,11 @@ namespace nana
 				if (this_cat != pos.cat)
 				{
 					this_cat = pos.cat;
-					ess.lister.get(this_cat)->make_sort_order();
+
+					auto & cat = *ess.lister.get(this_cat);
+					cat.make_sort_order();
+					cat.make_filtered_order();
+					ess.lister.update_lines(this_cat);
 				}
 			}
 
@@ -5980,6 +7912,39 @@ namespace nana
 			return !_m_ess().lister.active_sort(!freeze);
 		}
 
+		void listbox::filter(size_type col, std::string query, bool case_sensitive)
+		{
+			internal_scope_guard lock;
+			auto & ess = _m_ess();
+			for (auto & cat : ess.lister.cat_container())
+				ess.lister.filter(cat, col, query, case_sensitive);
+
+			ess.calc_content_size();
+			ess.update();
+		}
+
+		void listbox::filter(std::function<bool(const item_proxy&)> pred)
+		{
+			internal_scope_guard lock;
+			auto & ess = _m_ess();
+			for (auto & cat : ess.lister.cat_container())
+				ess.lister.filter(cat, pred);
+
+			ess.calc_content_size();
+			ess.update();
+		}
+
+		void listbox::unfilter()
+		{
+			internal_scope_guard lock;
+			auto & ess = _m_ess();
+			for (auto & cat : ess.lister.cat_container())
+				ess.lister.unfilter(cat);
+
+			ess.calc_content_size();
+			ess.update();
+		}
+
 		auto listbox::selected() const -> index_pairs
 		{
 			internal_scope_guard lock;
@@ -6013,7 +7978,7 @@ namespace nana
 
 		listbox::size_type listbox::size_item(size_type categ) const
 		{
-			return _m_ess().lister.size_item(categ);
+			return _m_ess().lister.get(categ)->size();
 		}
 
 		void listbox::enable_single(bool for_selection, bool category_limited)
@@ -6175,6 +8140,7 @@ namespace nana
 				if (i->key_ptr && nana::detail::pred_equal(p, i->key_ptr.get()))
 				{
 					cont.erase(i);
+					_m_ess().lister.invalidate_index();
 					return;
 				}
 			}
@@ -45,14 +45,8 @@ namespace detail
 		::GetObject(dw->pixmap, sizeof bmp, &bmp);
 		return nana::size(bmp.bmWidth, bmp.bmHeight);
 #elif defined(NANA_X11)
-        nana::detail::platform_spec & spec = nana::detail::platform_spec::instance();
-        Window root;
-        int x, y;
-        unsigned width, height;
-        unsigned border, depth;
-        nana::detail::platform_scope_guard psg;
-        ::XGetGeometry(spec.open_display(), dw->pixmap, &root, &x, &y, &width, &height, &border, &depth);
-		return nana::size(width, height);
+		//The pixmap may be larger than the graphics.
+		return dw->size;
 #endif
 	}
 
@@ -18,6 +18,8 @@
 #include <nana/gui/layout_utility.hpp>
 #include <nana/unicode_bidi.hpp>
 #include <algorithm>
+#include <mutex>
+#include <vector>
 #if defined(NANA_WINDOWS)
 	#include <windows.h>
 #elif defined(NANA_X11)
@@ -45,6 +47,152 @@ namespace paint
 {
 	namespace detail
 	{
+#if defined(NANA_X11)
+		/// Recycles the X resources of the released graphics.
+		/**
+		 * A GC can be used with any drawable of the same depth, the GCs are pooled per depth. A pixmap is pooled with
+		 * its XftDraw, and it's reused by a graphics which fits it without wasting too much memory, so that the churn of
+		 * the graphics, such as creating widgets and resizing them, doesn't create and free the X resources repeatedly.
+		 */
+		class drawable_pool
+		{
+			struct pooled_gc
+			{
+				Display* display;
+				int depth;
+				GC context;
+			};
+
+			struct pooled_pixmap
+			{
+				Display* display;
+				int depth;
+				Pixmap pixmap;
+				nana::size capacity;
+#if defined(NANA_USE_XFT)
+				XftDraw* xftdraw;
+#endif
+			};
+		public:
+			static constexpr std::size_t max_gcs = 64;
+			static constexpr std::size_t max_pixmap_bytes = 16 * 1024 * 1024;
+
+			static drawable_pool& instance()
+			{
+				static drawable_pool pool;
+				return pool;
+			}
+
+			/// Gives the resources of a graphics to the pool, or frees them if the pool is full.
+			void give(Display* disp, int depth, drawable_type dw)
+			{
+				std::lock_guard<std::mutex> lock{ mutex_ };
+
+				if (dw->context)
+				{
+					if (gcs_.size() < max_gcs)
+						gcs_.push_back(pooled_gc{ disp, depth, dw->context });
+					else
+						::XFreeGC(disp, dw->context);
+				}
+
+				//The graphics failed to be made
+				if (0 == dw->pixmap)
+					return;
+
+				auto const bytes = _m_bytes_of(dw->capacity);
+				if (bytes > max_pixmap_bytes / 4)
+				{
+					_m_free(pooled_pixmap{ disp, depth, dw->pixmap, dw->capacity
+#if defined(NANA_USE_XFT)
+						, dw->xftdraw
+#endif
+					});
+					return;
+				}
+
+				//Frees the oldest pixmaps
+				while (pixmap_bytes_ + bytes > max_pixmap_bytes)
+				{
+					pixmap_bytes_ -= _m_bytes_of(pixmaps_.front().capacity);
+					_m_free(pixmaps_.front());
+					pixmaps_.erase(pixmaps_.begin());
+				}
+
+				pixmaps_.push_back(pooled_pixmap{ disp, depth, dw->pixmap, dw->capacity
+#if defined(NANA_USE_XFT)
+					, dw->xftdraw
+#endif
+				});
+				pixmap_bytes_ += bytes;
+			}
+
+			/// Takes a GC of the depth, returns nullptr if there is not a pooled one.
+			GC take_gc(Display* disp, int depth)
+			{
+				std::lock_guard<std::mutex> lock{ mutex_ };
+				for (auto i = gcs_.rbegin(); i != gcs_.rend(); ++i)
+				{
+					if ((i->display == disp) && (i->depth == depth))
+					{
+						auto context = i->context;
+						gcs_.erase(std::next(i).base());
+						return context;
+					}
+				}
+				return nullptr;
+			}
+
+			/// Takes the smallest pixmap which fits the size, the area of the pixmap is at most twice the size.
+			bool take_pixmap(Display* disp, int depth, const nana::size& sz, drawable_type dw)
+			{
+				std::lock_guard<std::mutex> lock{ mutex_ };
+
+				auto const most = _m_bytes_of(sz) * 2;
+				auto fit = pixmaps_.end();
+				for (auto i = pixmaps_.begin(); i != pixmaps_.end(); ++i)
+				{
+					if ((i->display != disp) || (i->depth != depth) || (i->capacity.width < sz.width) || (i->capacity.height < sz.height))
+						continue;
+
+					auto const bytes = _m_bytes_of(i->capacity);
+					if ((bytes <= most) && ((fit == pixmaps_.end()) || (bytes < _m_bytes_of(fit->capacity))))
+						fit = i;
+				}
+
+				if (fit == pixmaps_.end())
+					return false;
+
+				dw->pixmap = fit->pixmap;
+				dw->capacity = fit->capacity;
+#if defined(NANA_USE_XFT)
+				dw->xftdraw = fit->xftdraw;
+#endif
+				pixmap_bytes_ -= _m_bytes_of(fit->capacity);
+				pixmaps_.erase(fit);
+				return true;
+			}
+		private:
+			static std::size_t _m_bytes_of(const nana::size& sz)
+			{
+				return static_cast<std::size_t>(sz.width) * sz.height * 4;
+			}
+
+			static void _m_free(const pooled_pixmap& pm)
+			{
+#if defined(NANA_USE_XFT)
+				::XftDrawDestroy(pm.xftdraw);
+#endif
+				::XFreePixmap(pm.display, pm.pixmap);
+			}
+		private:
+			std::mutex mutex_;
+			std::vector<pooled_gc> gcs_;
+			std::vector<pooled_pixmap> pixmaps_;	///< Ordered by the time the pixmaps were pooled.
+			std::size_t pixmap_bytes_{ 0 };
+		};
+#endif
+
 		struct drawable_deleter
 		{
 			void operator()(const drawable_type p) const
@@ -54,12 +202,9 @@ namespace paint
 #elif defined(NANA_X11)
 				if(p)
 				{
+					//The resources are given back under the depth which they are created for.
 					Display* disp = reinterpret_cast<Display*>(nana::detail::platform_spec::instance().open_display());
-	#if defined(NANA_USE_XFT)
-					::XftDrawDestroy(p->xftdraw);
-	#endif
-					::XFreeGC(disp, p->context);
-					::XFreePixmap(disp, p->pixmap);
+					drawable_pool::instance().give(disp, p->depth, p);
 					delete p;
 				}
 #endif
@@ -305,6 +450,11 @@ namespace paint
 		}
 
 		void graphics::make(const ::nana::size& sz)
+		{
+			_m_make(sz, sz);
+		}
+
+		void graphics::_m_make(const ::nana::size& sz, const ::nana::size& capacity)
 		{
 			if (impl_->handle == nullptr || impl_->size != sz)
 			{
@@ -371,35 +521,50 @@ namespace paint
 
 					Display* disp = spec.open_display();
 					int screen = DefaultScreen(disp);
-					Window root = ::XRootWindow(disp, screen);
-					auto pixmap = ::XCreatePixmap(disp, root, sz.width, sz.height, DefaultDepth(disp, screen));
-					if(spec.error_code)
-					{
-						spec.rev_error_handler();
-						throw std::bad_alloc();
-					}
-					auto context = ::XCreateGC(disp, pixmap, 0, 0);
-					if (spec.error_code)
+					auto const depth = DefaultDepth(disp, screen);
+					auto & pool = detail::drawable_pool::instance();
+
+					dw->depth = depth;
+
+					if (!pool.take_pixmap(disp, depth, capacity, dw.get()))
 					{
-						::XFreePixmap(disp, pixmap);
-						spec.rev_error_handler();
-						throw std::bad_alloc();
-					}
+						Window root = ::XRootWindow(disp, screen);
+						auto pixmap = ::XCreatePixmap(disp, root, capacity.width, capacity.height, depth);
+						if(spec.error_code)
+						{
+							spec.rev_error_handler();
+							throw std::bad_alloc();
+						}
 #	if defined(NANA_USE_XFT)
-					auto xftdraw = ::XftDrawCreate(disp, pixmap, spec.screen_visual(), spec.colormap());
-					if (spec.error_code)
-					{
-						::XFreeGC(disp, context);
-						::XFreePixmap(disp, pixmap);
+						auto xftdraw = ::XftDrawCreate(disp, pixmap, spec.screen_visual(), spec.colormap());
+						if (spec.error_code)
+						{
+							::XFreePixmap(disp, pixmap);
 
-						spec.rev_error_handler();
-						throw std::bad_alloc();
-					}
+							spec.rev_error_handler();
+							throw std::bad_alloc();
+						}
 
-					dw->xftdraw = xftdraw;
+						dw->xftdraw = xftdraw;
 #	endif
-					dw->pixmap = pixmap;
+						dw->pixmap = pixmap;
+						dw->capacity = capacity;
+					}
+
+					auto context = pool.take_gc(disp, depth);
+					if (nullptr == context)
+					{
+						context = ::XCreateGC(disp, dw->pixmap, 0, 0);
+						if (spec.error_code)
+						{
+							//The pixmap is given to the pool by the deleter of dw.
+							spec.rev_error_handler();
+							throw std::bad_alloc();
+						}
+					}
+
 					dw->context = context;
+					dw->size = sz;
 				}
 #endif
 				if(dw)
@@ -426,8 +591,41 @@ namespace paint
 
 		void graphics::resize(const ::nana::size& sz)
 		{
+			nana::size capacity = sz;
+#if defined(NANA_X11)
+			//The pixmap grows only. It's reused if it is large enough and it's not shared by other graphics objects,
+			//otherwise it grows by a quarter at least, so that an interactive resizing doesn't make a pixmap for each step.
+			if (impl_->handle && (!sz.empty()) && (impl_->platform_drawable.use_count() == 1))
+			{
+				auto & old = impl_->handle->capacity;
+				if ((old.width >= sz.width) && (old.height >= sz.height))
+				{
+					impl_->size = sz;
+					impl_->handle->size = sz;
+					impl_->changed = true;
+					return;
+				}
+
+				capacity.width = (std::max)(sz.width, old.width + old.width / 4);
+				capacity.height = (std::max)(sz.height, old.height + old.height / 4);
+			}
+#endif
 			graphics duplicate(std::move(*this));
-			make(sz);
+
+			//Keeps the font, the moved graphics is empty.
+			impl_->font_shadow = duplicate.impl_->font_shadow;
+			if (duplicate.impl_->handle)
+				impl_->font_shadow.impl_->real_font = duplicate.impl_->handle->font;
+
+			try
+			{
+				_m_make(sz, capacity);
+			}
+			catch (...)
+			{
+				impl_.swap(duplicate.impl_);
+				throw;
+			}
 			bitblt(0, 0, duplicate);
 		}
 
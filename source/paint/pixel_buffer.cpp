@@ -484,13 +484,8 @@ namespace nana{	namespace paint
 		return (want_r.height == read_lines);
 #elif defined(NANA_X11)
 		nana::detail::platform_spec & spec = nana::detail::platform_spec::instance();
-		Window root;
-		int x, y;
-		unsigned width, height;
-		unsigned border, depth;
 		nana::detail::platform_scope_guard psg;
 		::XFlush(spec.open_display());
-		::XGetGeometry(spec.open_display(), drawable->pixmap, &root, &x, &y, &width, &height, &border, &depth);
 		XImage * image = ::XGetImage(spec.open_display(), drawable->pixmap, r.x, r.y, r.width, r.height, AllPlanes, ZPixmap);
 
 		storage_ = std::make_shared<pixel_buffer_storage>(want_r.width, want_r.height);